@@ -0,0 +1,322 @@
+/******************************************************************************
+ *
+ * Module: Kernel
+ *
+ * File Name: kernel.c
+ *
+ * Description: Source file for the PendSV/SysTick preemptive thread kernel
+ *
+ * Author: Ahmed Osama
+ *
+ ******************************************************************************/
+#include "kernel.h"
+#include "systick.h"
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+/* Running and selected threads, not static because PendSV reaches them by symbol name */
+Kernel_ThreadType * volatile Kernel_Current;
+Kernel_ThreadType * volatile Kernel_Next;
+
+/* Bit (31 - priority) is set when that priority has a ready thread, so CLZ gives the highest one */
+static volatile uint32 Kernel_ReadyBitmap;
+static Kernel_ThreadType *Kernel_ReadyRing[KERNEL_PRIORITIES];
+
+static Kernel_ThreadType Kernel_IdleThread;
+static uint32 Kernel_IdleStack[KERNEL_IDLE_STACK_WORDS] __attribute__((aligned(8)));
+
+/* main's context is saved here by the first switch and never resumed */
+static Kernel_ThreadType Kernel_BootThread;
+static uint32 Kernel_BootStack[KERNEL_BOOT_STACK_WORDS] __attribute__((aligned(8)));
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+/* Appends a thread at the tail of its priority ring, call with exceptions masked */
+static void Kernel_MakeReady(Kernel_ThreadType *Thread)
+{
+    Kernel_ThreadType **ring = &Kernel_ReadyRing[Thread->Priority];
+
+    if (*ring == NULL_PTR) {
+        Thread->Next = Thread;
+        Thread->Prev = Thread;
+        *ring = Thread;
+        Kernel_ReadyBitmap |= (uint32)1 << (31 - Thread->Priority);
+    } else {
+        Thread->Next = *ring;
+        Thread->Prev = (*ring)->Prev;
+        (*ring)->Prev->Next = Thread;
+        (*ring)->Prev = Thread;
+    }
+    Thread->Ready = TRUE;
+}
+
+/* Removes a thread from its priority ring, call with exceptions masked */
+static void Kernel_MakeBlocked(Kernel_ThreadType *Thread)
+{
+    Kernel_ThreadType **ring = &Kernel_ReadyRing[Thread->Priority];
+
+    if (Thread->Next == Thread) {
+        *ring = NULL_PTR;
+        Kernel_ReadyBitmap &= ~((uint32)1 << (31 - Thread->Priority));
+    } else {
+        Thread->Prev->Next = Thread->Next;
+        Thread->Next->Prev = Thread->Prev;
+        if (*ring == Thread) {
+            *ring = Thread->Next;
+        }
+    }
+    Thread->Ready = FALSE;
+}
+
+/* Selects the head of the highest ready priority in O(1) and pends PendSV if it is not running */
+static void Kernel_Schedule(void)
+{
+    Kernel_ThreadType *next = Kernel_ReadyRing[__builtin_clz(Kernel_ReadyBitmap)];
+
+    Kernel_Next = next;
+    if (next != Kernel_Current) {
+        NVIC_ICSR_REG = NVIC_ICSR_PENDSVSET_MASK;
+    }
+}
+
+/* Sleep timer expiry, runs from SysTick_Handler */
+static void Kernel_Wake(void *Context)
+{
+    NVIC_CriticalStateType state = NVIC_EnterCritical();
+    Kernel_MakeReady((Kernel_ThreadType *)Context);
+    Kernel_Schedule();
+    NVIC_ExitCritical(state);
+}
+
+/* Return address of every thread entry function */
+static void Kernel_ThreadExit(void)
+{
+    Disable_Exceptions();
+    Kernel_MakeBlocked(Kernel_Current);
+    Kernel_Schedule();
+    Enable_Exceptions();
+    for (;;) {
+    }
+}
+
+static void Kernel_Idle(void *Argument)
+{
+    (void)Argument;
+    for (;;) {
+        Wait_For_Interrupt();
+    }
+}
+
+/* Lays out the frame PendSV expects over the hardware exception frame and makes the thread ready */
+static void Kernel_ThreadSetup(Kernel_ThreadType *Thread, Kernel_ThreadEntryType Entry, void *Argument,
+                              uint32 *Stack, uint32 Stack_Words, uint8 Priority)
+{
+    uint32 *sp = (uint32 *)((uint32)(Stack + Stack_Words) & ~(uint32)7);
+    NVIC_CriticalStateType state;
+    uint8 i;
+
+    /* Hardware frame: r0-r3, r12, lr, pc, xPSR */
+    *(--sp) = KERNEL_INITIAL_XPSR;
+    *(--sp) = (uint32)Entry;
+    *(--sp) = (uint32)Kernel_ThreadExit;
+    for (i = 0; i < 4; i++) {
+        *(--sp) = 0;                        /* r12, r3, r2, r1 */
+    }
+    *(--sp) = (uint32)Argument;             /* r0 */
+
+    /* Software frame: r4-r11, EXC_RETURN */
+    *(--sp) = KERNEL_INITIAL_EXC_RETURN;
+    for (i = 0; i < 8; i++) {
+        *(--sp) = 0;
+    }
+
+    Thread->Stack_Pointer = sp;
+    Thread->Priority = Priority;
+    SysTick_TimerSetup(&Thread->Sleep_Timer, Kernel_Wake, Thread);
+
+    state = NVIC_EnterCritical();
+    Kernel_MakeReady(Thread);
+    if (Kernel_Current != &Kernel_BootThread) {
+        Kernel_Schedule();
+    }
+    NVIC_ExitCritical(state);
+}
+
+/* Context switch. Saves r4-r11 and EXC_RETURN on the thread stack, plus s16-s31 only when
+ * the thread has an FPU frame (EXC_RETURN bit 4 clear), so lazy FPU stacking is preserved. */
+__attribute__((naked)) static void Kernel_PendSVHandler(void)
+{
+    __asm volatile (
+        " MRS      r0, PSP             \n"
+#if defined(__ARM_FP)
+        " TST      lr, #0x10           \n"
+        " IT       EQ                  \n"
+        " VSTMDBEQ r0!, {s16-s31}      \n"
+#endif
+        " STMDB    r0!, {r4-r11, lr}   \n"
+        " CPSID    I                   \n"
+        " LDR      r1, =Kernel_Current \n"
+        " LDR      r2, [r1]            \n"
+        " STR      r0, [r2]            \n"
+        " LDR      r3, =Kernel_Next    \n"
+        " LDR      r2, [r3]            \n"
+        " STR      r2, [r1]            \n"
+        " CPSIE    I                   \n"
+        " LDR      r0, [r2]            \n"
+        " LDMIA    r0!, {r4-r11, lr}   \n"
+#if defined(__ARM_FP)
+        " TST      lr, #0x10           \n"
+        " IT       EQ                  \n"
+        " VLDMIAEQ r0!, {s16-s31}      \n"
+#endif
+        " MSR      PSP, r0             \n"
+        " ISB                          \n"
+        " BX       lr                  \n"
+    );
+}
+
+/*****************************************************************************
+ * Service Name: Kernel_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Resets the scheduler and creates the idle thread, which keeps
+ *              the ready bitmap from ever being empty.
+ *****************************************************************************/
+void Kernel_Init(void)
+{
+    uint8 priority;
+
+    Kernel_ReadyBitmap = 0;
+    for (priority = 0; priority < KERNEL_PRIORITIES; priority++) {
+        Kernel_ReadyRing[priority] = NULL_PTR;
+    }
+    Kernel_Current = &Kernel_BootThread;
+    Kernel_Next = &Kernel_BootThread;
+    Kernel_ThreadSetup(&Kernel_IdleThread, Kernel_Idle, NULL_PTR,
+                       Kernel_IdleStack, KERNEL_IDLE_STACK_WORDS, KERNEL_IDLE_PRIORITY);
+}
+
+/*****************************************************************************
+ * Service Name: Kernel_ThreadCreate
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): Entry - Thread function
+ *                 Argument - Passed to Entry in r0
+ *                 Stack - Thread stack
+ *                 Stack_Words - Size of Stack in words
+ *                 Priority - 0 (highest) .. KERNEL_IDLE_PRIORITY - 1
+ * Parameters (inout): None
+ * Parameters (out): Thread - Thread control block to initialize
+ * Return value: FALSE if Priority is out of range, TRUE otherwise
+ * Description: Lays out the frame PendSV expects (r4-r11, EXC_RETURN) over the
+ *              hardware exception frame, then makes the thread ready.
+ *****************************************************************************/
+boolean Kernel_ThreadCreate(Kernel_ThreadType *Thread, Kernel_ThreadEntryType Entry, void *Argument,
+                            uint32 *Stack, uint32 Stack_Words, uint8 Priority)
+{
+    /* The idle priority is reserved, and anything past it would index beyond the ready rings */
+    if (Priority >= KERNEL_IDLE_PRIORITY) {
+        return FALSE;
+    }
+    Kernel_ThreadSetup(Thread, Entry, Argument, Stack, Stack_Words, Priority);
+    return TRUE;
+}
+
+/*****************************************************************************
+ * Service Name: Kernel_Start
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Gives PendSV the lowest priority so switches never preempt an
+ *              ISR, moves thread mode to PSP on a scratch stack and lets the
+ *              first PendSV switch into the highest priority ready thread.
+ *              NVIC_RelocateVectorTable must have been called first.
+ *****************************************************************************/
+void Kernel_Start(void)
+{
+    NVIC_RegisterExceptionHandler(EXCEPTION_PEND_SV_TYPE, Kernel_PendSVHandler);
+    NVIC_SetPriorityException(EXCEPTION_PEND_SV_TYPE, (NVIC_ExceptionPriorityType)NVIC_PRIORITY_LEVEL_MASK);
+
+    Disable_Exceptions();
+    Kernel_Current = &Kernel_BootThread;
+    Kernel_Schedule();
+    __asm volatile (
+        " MSR   PSP, %0     \n"
+        " MOVS  r0, #2      \n"             /* CONTROL.SPSEL = 1, privileged, FPCA cleared */
+        " MSR   CONTROL, r0 \n"
+        " ISB               \n"
+        " CPSIE I           \n"             /* The pending PendSV is taken here */
+        :: "r" (&Kernel_BootStack[KERNEL_BOOT_STACK_WORDS]) : "r0", "memory");
+    for (;;) {
+    }
+}
+
+/*****************************************************************************
+ * Service Name: Kernel_Yield
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Moves the calling thread to the tail of its priority ring.
+ *****************************************************************************/
+void Kernel_Yield(void)
+{
+    NVIC_CriticalStateType state = NVIC_EnterCritical();
+    Kernel_ReadyRing[Kernel_Current->Priority] = Kernel_Current->Next;
+    Kernel_Schedule();
+    NVIC_ExitCritical(state);
+}
+
+/*****************************************************************************
+ * Service Name: Kernel_Sleep
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Ticks - SysTick periods to sleep
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Blocks the calling thread on its own software timer, the
+ *              timer expiry makes it ready again.
+ *****************************************************************************/
+void Kernel_Sleep(uint32 Ticks)
+{
+    NVIC_CriticalStateType state = NVIC_EnterCritical();
+    Kernel_MakeBlocked(Kernel_Current);
+    SysTick_TimerStart(&Kernel_Current->Sleep_Timer, Ticks, 0);
+    Kernel_Schedule();
+    NVIC_ExitCritical(state);
+}
+
+/*****************************************************************************
+ * Service Name: Kernel_Tick
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Round-robin time slice among the ready threads sharing the
+ *              running thread priority.
+ *****************************************************************************/
+void Kernel_Tick(void)
+{
+    NVIC_CriticalStateType state = NVIC_EnterCritical();
+    if ((Kernel_Current->Ready != FALSE) && (Kernel_Current->Next != Kernel_Current)) {
+        Kernel_ReadyRing[Kernel_Current->Priority] = Kernel_Current->Next;
+        Kernel_Schedule();
+    }
+    NVIC_ExitCritical(state);
+}
@@ -0,0 +1,84 @@
+/******************************************************************************
+ *
+ * Module: Kernel
+ *
+ * File Name: kernel.h
+ *
+ * Description: Header file for the PendSV/SysTick preemptive thread kernel
+ *
+ * Author: Ahmed Osama
+ *
+ *******************************************************************************/
+
+#ifndef KERNEL_H_
+#define KERNEL_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+#include "nvic.h"
+#include "systick_timers.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Thread priorities 0 (highest) .. 30, 31 is taken by the idle thread */
+#define KERNEL_PRIORITIES                    32
+#define KERNEL_IDLE_PRIORITY                 (KERNEL_PRIORITIES - 1)
+
+/* Stack sizes in words of the internal idle thread and of the scratch stack used to leave main */
+#ifndef KERNEL_IDLE_STACK_WORDS
+#define KERNEL_IDLE_STACK_WORDS              64
+#endif
+#define KERNEL_BOOT_STACK_WORDS              64
+
+/* Initial xPSR (Thumb bit) and EXC_RETURN (thread mode, PSP, no FPU frame) of a new thread */
+#define KERNEL_INITIAL_XPSR                  0x01000000
+#define KERNEL_INITIAL_EXC_RETURN            0xFFFFFFFD
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef void (*Kernel_ThreadEntryType)(void *Argument);
+
+/* Caller-owned thread control block */
+typedef struct Kernel_Thread
+{
+    uint32 *Stack_Pointer;              /* Saved PSP, must stay the first member (used by PendSV) */
+    struct Kernel_Thread *Next;         /* Ready ring of the thread priority */
+    struct Kernel_Thread *Prev;
+    uint8 Priority;
+    boolean Ready;
+    SysTick_TimerType Sleep_Timer;
+} Kernel_ThreadType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+// Clears the ready bitmap and creates the idle thread
+void Kernel_Init(void);
+
+// Builds the initial stack frame of a thread and makes it ready, FALSE if Priority >= KERNEL_IDLE_PRIORITY
+boolean Kernel_ThreadCreate(Kernel_ThreadType *Thread, Kernel_ThreadEntryType Entry, void *Argument,
+                            uint32 *Stack, uint32 Stack_Words, uint8 Priority);
+
+// Sets PendSV to the lowest priority and switches from main to the highest priority ready thread, never returns
+void Kernel_Start(void) __attribute__((noreturn));
+
+// Gives the CPU to the next ready thread of the same priority
+void Kernel_Yield(void);
+
+// Blocks the calling thread for a number of SysTick periods
+void Kernel_Sleep(uint32 Ticks);
+
+// Time slice: rotates the ready ring of the running priority, called from SysTick_Handler
+void Kernel_Tick(void);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* KERNEL_H_ */
@@ -1,197 +1,1031 @@
-/******************************************************************************
- *
- * Module: NVIC
- *
- * File Name: NVIC.c
- *
- * Description: Source file for the ARM Cortex M4 NVIC driver
- *
- * Author: Ahmed Osama
- *
- ******************************************************************************/
-#include "nvic.h"
-
-/*****************************************************************************
- * Service Name: NVIC_EnableIRQ
- * Sync/Async: Synchronous
- * Reentrancy: Non-reentrant
- * Parameters (in): IRQ_Num - Interrupt request number
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: Enables the specified IRQ in the NVIC registers.
- *****************************************************************************/
-void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num)
-{
-    Enable_Exceptions();
-    Enable_Faults();
-    if (IRQ_Num < 32) {
-        NVIC_EN0_REG |= (1 << IRQ_Num); // Enable interrupt in NVIC_EN0
-    } else if (IRQ_Num < 64) {
-        NVIC_EN1_REG |= (1 << (IRQ_Num - 32)); // Enable interrupt in NVIC_EN1
-    } else if (IRQ_Num < 96) {
-        NVIC_EN2_REG |= (1 << (IRQ_Num - 64)); // Enable interrupt in NVIC_EN2
-    } else if (IRQ_Num < 128) {
-        NVIC_EN3_REG |= (1 << (IRQ_Num - 96)); // Enable interrupt in NVIC_EN3
-    } else if (IRQ_Num < 160) {
-        NVIC_EN4_REG |= (1 << (IRQ_Num - 128)); // Enable interrupt in NVIC_EN4
-    }
-}
-
-/*****************************************************************************
- * Service Name: NVIC_DisableIRQ
- * Sync/Async: Synchronous
- * Reentrancy: Non-reentrant
- * Parameters (in): IRQ_Num - Interrupt request number
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: Disables the specified IRQ in the NVIC registers.
- *****************************************************************************/
-void NVIC_DisableIRQ(NVIC_IRQType IRQ_Num)
-{
-    if (IRQ_Num < 32) {
-        NVIC_DIS0_REG |= (1 << IRQ_Num);
-    } else if (IRQ_Num < 64) {
-        NVIC_DIS1_REG |= (1 << (IRQ_Num - 32));
-    } else if (IRQ_Num < 96) {
-        NVIC_DIS2_REG |= (1 << (IRQ_Num - 64));
-    } else if (IRQ_Num < 128) {
-        NVIC_DIS3_REG |= (1 << (IRQ_Num - 96));
-    } else if (IRQ_Num < 160) {
-        NVIC_DIS4_REG |= (1 << (IRQ_Num - 128));
-    }
-}
-
-/*****************************************************************************
- * Service Name: NVIC_SetPriorityIRQ
- * Sync/Async: Synchronous
- * Reentrancy: Non-reentrant
- * Parameters (in): IRQ_Num - Interrupt request number
- *                 IRQ_Priority - Priority of the interrupt
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: Sets the priority level of a specified IRQ.
- *****************************************************************************/
-void NVIC_SetPriorityIRQ(NVIC_IRQType IRQ_Num, NVIC_IRQPriorityType IRQ_Priority)
-{
-    uint32 reg_num = IRQ_Num / 4;
-    uint32 reg_address = (uint32)0xE000E400 + (0x4 * reg_num);
-    uint32 loc_in_reg = ((float32)IRQ_Num / 4 - (uint32)(IRQ_Num / 4)) * 100;
-
-    if (loc_in_reg == 0) {
-        (*((volatile uint32 *)reg_address)) &= ~(7 << 5);
-        (*((volatile uint32 *)reg_address)) |= (IRQ_Priority << 5);
-    } else if (loc_in_reg == 25) {
-        (*((volatile uint32 *)reg_address)) &= ~(7 << 13);
-        (*((volatile uint32 *)reg_address)) |= (IRQ_Priority << 13);
-    } else if (loc_in_reg == 50) {
-        (*((volatile uint32 *)reg_address)) &= ~(7 << 21);
-        (*((volatile uint32 *)reg_address)) |= (IRQ_Priority << 21);
-    } else if (loc_in_reg == 75) {
-        (*((volatile uint32 *)reg_address)) &= ~(7 << 29);
-        (*((volatile uint32 *)reg_address)) |= (IRQ_Priority << 29);
-    }
-}
-
-/*****************************************************************************
- * Service Name: NVIC_EnableException
- * Sync/Async: Synchronous
- * Reentrancy: Non-reentrant
- * Parameters (in): Exception_Num - Type of exception to enable
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: Enables a specific system or fault exception.
- *****************************************************************************/
-void NVIC_EnableException(NVIC_ExceptionType Exception_Num)
-{
-    switch (Exception_Num) {
-    case EXCEPTION_MEM_FAULT_TYPE:
-        NVIC_SYSTEM_SYSHNDCTRL |= (1 << 16);
-        break;
-    case EXCEPTION_BUS_FAULT_TYPE:
-        NVIC_SYSTEM_SYSHNDCTRL |= (1 << 17);
-        break;
-    case EXCEPTION_USAGE_FAULT_TYPE:
-        NVIC_SYSTEM_SYSHNDCTRL |= (1 << 18);
-        break;
-    case EXCEPTION_DEBUG_MONITOR_TYPE:
-        NVIC_SYSTEM_SYSHNDCTRL |= (1 << 8);
-        break;
-    case EXCEPTION_SYSTICK_TYPE:
-        SYSTICK_CTRL_REG |= (1 << 1);
-        break;
-    default:
-        break;
-    }
-}
-
-/*****************************************************************************
- * Service Name: NVIC_DisableException
- * Sync/Async: Synchronous
- * Reentrancy: Non-reentrant
- * Parameters (in): Exception_Num - Type of exception to disable
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: Disables a specific system or fault exception.
- *****************************************************************************/
-void NVIC_DisableException(NVIC_ExceptionType Exception_Num)
-{
-    switch (Exception_Num) {
-    case EXCEPTION_MEM_FAULT_TYPE:
-        NVIC_SYSTEM_SYSHNDCTRL &= ~(1 << 16);
-        break;
-    case EXCEPTION_BUS_FAULT_TYPE:
-        NVIC_SYSTEM_SYSHNDCTRL &= ~(1 << 17);
-        break;
-    case EXCEPTION_USAGE_FAULT_TYPE:
-        NVIC_SYSTEM_SYSHNDCTRL &= ~(1 << 18);
-        break;
-    case EXCEPTION_DEBUG_MONITOR_TYPE:
-        NVIC_SYSTEM_SYSHNDCTRL &= ~(1 << 8);
-        break;
-    case EXCEPTION_SYSTICK_TYPE:
-        SYSTICK_CTRL_REG &= ~(1 << 1);
-        break;
-    default:
-        break;
-    }
-}
-
-/*****************************************************************************
- * Service Name: NVIC_SetPriorityException
- * Sync/Async: Synchronous
- * Reentrancy: Non-reentrant
- * Parameters (in): Exception_Num - Type of exception
- *                 Exception_Priority - Priority to set
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: Sets the priority level of a specified system or fault exception.
- *****************************************************************************/
-void NVIC_SetPriorityException(NVIC_ExceptionType Exception_Num, NVIC_ExceptionPriorityType Exception_Priority)
-{
-    switch (Exception_Num) {
-    case EXCEPTION_MEM_FAULT_TYPE:
-        NVIC_SYSTEM_PRI1_REG &= ~MEM_FAULT_PRIORITY_MASK;
-        NVIC_SYSTEM_PRI1_REG |= (Exception_Priority << MEM_FAULT_PRIORITY_BITS_POS);
-        break;
-    case EXCEPTION_BUS_FAULT_TYPE:
-        NVIC_SYSTEM_PRI1_REG &= ~BUS_FAULT_PRIORITY_MASK;
-        NVIC_SYSTEM_PRI1_REG |= (Exception_Priority << BUS_FAULT_PRIORITY_BITS_POS);
-        break;
-    case EXCEPTION_USAGE_FAULT_TYPE:
-        NVIC_SYSTEM_PRI1_REG &= ~USAGE_FAULT_PRIORITY_MASK;
-        NVIC_SYSTEM_PRI1_REG |= (Exception_Priority << USAGE_FAULT_PRIORITY_BITS_POS);
-        break;
-    case EXCEPTION_SYSTICK_TYPE:
-        NVIC_SYSTEM_PRI3_REG &= ~SYSTICK_PRIORITY_MASK;
-        NVIC_SYSTEM_PRI3_REG |= (Exception_Priority << SYSTICK_PRIORITY_BITS_POS);
-        break;
-    default:
-        break;
-    }
-}
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC.c
+ *
+ * Description: Source file for the ARM Cortex M4 NVIC driver
+ *
+ * Author: Ahmed Osama
+ *
+ ******************************************************************************/
+#include "nvic.h"
+#include "nvic_cfg.h"
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+/* SRAM copy of the vector table used once NVIC_RelocateVectorTable has run */
+static volatile NVIC_HandlerType NVIC_RamVectorTable[NVIC_VECTOR_COUNT]
+    __attribute__((aligned(NVIC_VECTOR_TABLE_ALIGN)));
+
+/* Set by NVIC_RequestThreadWork, consumed by NVIC_SleepOnExit */
+static volatile boolean NVIC_ThreadWorkPending = FALSE;
+
+/* Vector number of each NVIC_ExceptionType */
+static const uint8 NVIC_ExceptionVector[] =
+{
+    1,      /* EXCEPTION_RESET_TYPE         */
+    2,      /* EXCEPTION_NMI_TYPE           */
+    3,      /* EXCEPTION_HARD_FAULT_TYPE    */
+    4,      /* EXCEPTION_MEM_FAULT_TYPE     */
+    5,      /* EXCEPTION_BUS_FAULT_TYPE     */
+    6,      /* EXCEPTION_USAGE_FAULT_TYPE   */
+    11,     /* EXCEPTION_SVC_TYPE           */
+    12,     /* EXCEPTION_DEBUG_MONITOR_TYPE */
+    14,     /* EXCEPTION_PEND_SV_TYPE       */
+    15      /* EXCEPTION_SYSTICK_TYPE       */
+};
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+/* Number of implemented priority bits used for sub-priority under the current PRIGROUP */
+static uint8 NVIC_SubPriorityBits(void)
+{
+    uint32 group = (NVIC_AIRCR_REG & NVIC_AIRCR_PRIGROUP_MASK) >> NVIC_AIRCR_PRIGROUP_BITS_POS;
+    return ((group + NVIC_PRIORITY_BITS) < 7) ? 0 : (uint8)(group + NVIC_PRIORITY_BITS - 7);
+}
+
+/*******************************************************************************
+ *                      Static Configuration Image Generation                  *
+ *******************************************************************************/
+
+/* EN word n = OR of the bit masks of every enabled table entry living in word n */
+#define NVIC_CFG_EN_BIT(IRQ, PRIORITY, ENABLED, WORD) \
+    | ((((ENABLED) != FALSE) && (NVIC_IRQ_REG_INDEX(IRQ) == (WORD))) ? NVIC_IRQ_BIT_MASK(IRQ) : 0)
+#define NVIC_CFG_EN_BIT_0(IRQ, PRIORITY, ENABLED)   NVIC_CFG_EN_BIT(IRQ, PRIORITY, ENABLED, 0)
+#define NVIC_CFG_EN_BIT_1(IRQ, PRIORITY, ENABLED)   NVIC_CFG_EN_BIT(IRQ, PRIORITY, ENABLED, 1)
+#define NVIC_CFG_EN_BIT_2(IRQ, PRIORITY, ENABLED)   NVIC_CFG_EN_BIT(IRQ, PRIORITY, ENABLED, 2)
+#define NVIC_CFG_EN_BIT_3(IRQ, PRIORITY, ENABLED)   NVIC_CFG_EN_BIT(IRQ, PRIORITY, ENABLED, 3)
+#define NVIC_CFG_EN_BIT_4(IRQ, PRIORITY, ENABLED)   NVIC_CFG_EN_BIT(IRQ, PRIORITY, ENABLED, 4)
+#define NVIC_CFG_EN_BIT_5(IRQ, PRIORITY, ENABLED)   NVIC_CFG_EN_BIT(IRQ, PRIORITY, ENABLED, 5)
+#define NVIC_CFG_EN_BIT_6(IRQ, PRIORITY, ENABLED)   NVIC_CFG_EN_BIT(IRQ, PRIORITY, ENABLED, 6)
+#define NVIC_CFG_EN_BIT_7(IRQ, PRIORITY, ENABLED)   NVIC_CFG_EN_BIT(IRQ, PRIORITY, ENABLED, 7)
+#define NVIC_CFG_EN_WORD(WORD)                      ((uint32)0 NVIC_CFG_IRQ_TABLE(NVIC_CFG_EN_BIT_##WORD))
+
+/* One designated byte lane per table entry */
+#define NVIC_CFG_IPR_BYTE(IRQ, PRIORITY, ENABLED) \
+    [IRQ] = (uint8)((PRIORITY) << NVIC_PRIORITY_SHIFT),
+#define NVIC_CFG_SYSPRI_BYTE(EXCEPTION, PRIORITY) \
+    [NVIC_EXCEPTION_SYSPRI_BYTE(EXCEPTION)] = (uint8)((PRIORITY) << NVIC_PRIORITY_SHIFT),
+
+/* Number of table entries, usable in #if: an empty table leaves its image at zero
+ * instead of expanding to an empty initializer list, which C99 does not allow */
+#define NVIC_CFG_IRQ_COUNT_ONE(IRQ, PRIORITY, ENABLED)      + 1
+#define NVIC_CFG_EXCEPTION_COUNT_ONE(EXCEPTION, PRIORITY)   + 1
+#define NVIC_CFG_IRQ_ENTRIES                 (0 NVIC_CFG_IRQ_TABLE(NVIC_CFG_IRQ_COUNT_ONE))
+#define NVIC_CFG_EXCEPTION_ENTRIES           (0 NVIC_CFG_EXCEPTION_TABLE(NVIC_CFG_EXCEPTION_COUNT_ONE))
+
+/* Compile-time checks: a duplicated entry redeclares an enumerator, an out of range priority
+ * gives a negative array size and a fixed priority exception indexes past SystemPriority.Bytes */
+#define NVIC_CFG_IRQ_UNIQUE(IRQ, PRIORITY, ENABLED)     NVIC_CFG_IRQ_ENTRY_##IRQ,
+#define NVIC_CFG_EXCEPTION_UNIQUE(EXCEPTION, PRIORITY)  NVIC_CFG_EXCEPTION_ENTRY_##EXCEPTION,
+#define NVIC_CFG_PRIORITY_VALID(IRQ, PRIORITY, ENABLED) && ((PRIORITY) <= NVIC_PRIORITY_LEVEL_MASK)
+#define NVIC_CFG_EXCEPTION_PRIORITY_VALID(EXCEPTION, PRIORITY) && ((PRIORITY) <= NVIC_PRIORITY_LEVEL_MASK)
+
+enum { NVIC_CFG_IRQ_TABLE(NVIC_CFG_IRQ_UNIQUE) NVIC_CFG_IRQ_ENTRY_COUNT };
+enum { NVIC_CFG_EXCEPTION_TABLE(NVIC_CFG_EXCEPTION_UNIQUE) NVIC_CFG_EXCEPTION_ENTRY_COUNT };
+typedef char NVIC_CfgIRQPriorityCheck[(1 NVIC_CFG_IRQ_TABLE(NVIC_CFG_PRIORITY_VALID)) ? 1 : -1];
+typedef char NVIC_CfgExceptionPriorityCheck[(1 NVIC_CFG_EXCEPTION_TABLE(NVIC_CFG_EXCEPTION_PRIORITY_VALID)) ? 1 : -1];
+typedef char NVIC_DeviceIRQLinesCheck[((NVIC_DEVICE_IRQ_LINES <= 240) && (NVIC_IRQ_COUNT <= NVIC_DEVICE_IRQ_LINES)) ? 1 : -1];
+typedef char NVIC_DevicePriorityBitsCheck[((NVIC_PRIORITY_BITS >= 3) && (NVIC_PRIORITY_BITS <= 4)) ? 1 : -1];
+
+static const NVIC_ConfigImageType NVIC_ConfigImage =
+{
+    .EnableWords = {
+        NVIC_CFG_EN_WORD(0),
+#if NVIC_DEVICE_IRQ_LINES > 32
+        NVIC_CFG_EN_WORD(1),
+#endif
+#if NVIC_DEVICE_IRQ_LINES > 64
+        NVIC_CFG_EN_WORD(2),
+#endif
+#if NVIC_DEVICE_IRQ_LINES > 96
+        NVIC_CFG_EN_WORD(3),
+#endif
+#if NVIC_DEVICE_IRQ_LINES > 128
+        NVIC_CFG_EN_WORD(4),
+#endif
+#if NVIC_DEVICE_IRQ_LINES > 160
+        NVIC_CFG_EN_WORD(5),
+#endif
+#if NVIC_DEVICE_IRQ_LINES > 192
+        NVIC_CFG_EN_WORD(6),
+#endif
+#if NVIC_DEVICE_IRQ_LINES > 224
+        NVIC_CFG_EN_WORD(7),
+#endif
+    },
+#if NVIC_CFG_IRQ_ENTRIES > 0
+    .Priority = { .Bytes = { NVIC_CFG_IRQ_TABLE(NVIC_CFG_IPR_BYTE) } },
+#endif
+#if NVIC_CFG_EXCEPTION_ENTRIES > 0
+    .SystemPriority = { .Bytes = { NVIC_CFG_EXCEPTION_TABLE(NVIC_CFG_SYSPRI_BYTE) } },
+#endif
+};
+
+/*****************************************************************************
+ * Service Name: NVIC_EnableIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Interrupt request number
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Enables the specified IRQ in the NVIC registers.
+ *              EN registers are write-1-to-set, so a single store is enough
+ *              and the global PRIMASK/FAULTMASK state is left untouched.
+ *****************************************************************************/
+void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num)
+{
+    NVIC_ISER_REGS[NVIC_IRQ_REG_INDEX(IRQ_Num)] = NVIC_IRQ_BIT_MASK(IRQ_Num);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_DisableIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Interrupt request number
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Disables the specified IRQ in the NVIC registers.
+ *              DIS registers are write-1-to-clear, so a single store is enough.
+ *****************************************************************************/
+void NVIC_DisableIRQ(NVIC_IRQType IRQ_Num)
+{
+    NVIC_ICER_REGS[NVIC_IRQ_REG_INDEX(IRQ_Num)] = NVIC_IRQ_BIT_MASK(IRQ_Num);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_SetPending
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Interrupt request number
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Sets the pending state of the specified IRQ (write-1-to-set).
+ *****************************************************************************/
+void NVIC_SetPending(NVIC_IRQType IRQ_Num)
+{
+    NVIC_ISPR_REGS[NVIC_IRQ_REG_INDEX(IRQ_Num)] = NVIC_IRQ_BIT_MASK(IRQ_Num);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_ClearPending
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Interrupt request number
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Clears the pending state of the specified IRQ (write-1-to-clear).
+ *****************************************************************************/
+void NVIC_ClearPending(NVIC_IRQType IRQ_Num)
+{
+    NVIC_ICPR_REGS[NVIC_IRQ_REG_INDEX(IRQ_Num)] = NVIC_IRQ_BIT_MASK(IRQ_Num);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_IsPending
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Interrupt request number
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the IRQ is pending
+ * Description: Reads the pending state of the specified IRQ.
+ *****************************************************************************/
+boolean NVIC_IsPending(NVIC_IRQType IRQ_Num)
+{
+    return (NVIC_ISPR_REGS[NVIC_IRQ_REG_INDEX(IRQ_Num)] & NVIC_IRQ_BIT_MASK(IRQ_Num)) ? TRUE : FALSE;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_IsActive
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Interrupt request number
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the IRQ is active
+ * Description: Reads the active state of the specified IRQ.
+ *****************************************************************************/
+boolean NVIC_IsActive(NVIC_IRQType IRQ_Num)
+{
+    return (NVIC_IABR_REGS[NVIC_IRQ_REG_INDEX(IRQ_Num)] & NVIC_IRQ_BIT_MASK(IRQ_Num)) ? TRUE : FALSE;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_TriggerIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Interrupt request number
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Pends the specified IRQ with a single store to STIR.
+ *              Unprivileged code needs CCR.USERSETMPEND set to use it.
+ *****************************************************************************/
+void NVIC_TriggerIRQ(NVIC_IRQType IRQ_Num)
+{
+    NVIC_STIR_REG = (uint32)IRQ_Num;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_SetPriorityIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Interrupt request number
+ *                 IRQ_Priority - Priority of the interrupt
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Sets the priority level of a specified IRQ.
+ *              The PRIn registers are byte accessible, so the IRQ byte lane
+ *              (0xE000E400 + IRQ_Num) is written directly without any RMW.
+ *****************************************************************************/
+void NVIC_SetPriorityIRQ(NVIC_IRQType IRQ_Num, NVIC_IRQPriorityType IRQ_Priority)
+{
+    NVIC_IPR_REGS[IRQ_Num] = (uint8)((IRQ_Priority & NVIC_PRIORITY_LEVEL_MASK) << NVIC_PRIORITY_SHIFT);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_GetPriorityIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Interrupt request number
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_IRQPriorityType - Priority currently set for the IRQ
+ * Description: Reads back the priority level of a specified IRQ.
+ *****************************************************************************/
+NVIC_IRQPriorityType NVIC_GetPriorityIRQ(NVIC_IRQType IRQ_Num)
+{
+    return (NVIC_IRQPriorityType)(NVIC_IPR_REGS[IRQ_Num] >> NVIC_PRIORITY_SHIFT);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_IRQSetClear
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): IRQ_Set - Set to empty
+ * Return value: None
+ * Description: Removes every IRQ from the set.
+ *****************************************************************************/
+void NVIC_IRQSetClear(NVIC_IRQSetType *IRQ_Set)
+{
+    uint8 i;
+    for (i = 0; i < NVIC_IRQ_REG_COUNT; i++) {
+        IRQ_Set->Words[i] = 0;
+    }
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_IRQSetAdd
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Interrupt request number
+ * Parameters (inout): IRQ_Set - Set to update
+ * Parameters (out): None
+ * Return value: None
+ * Description: Adds the specified IRQ to the set.
+ *****************************************************************************/
+void NVIC_IRQSetAdd(NVIC_IRQSetType *IRQ_Set, NVIC_IRQType IRQ_Num)
+{
+    IRQ_Set->Words[NVIC_IRQ_REG_INDEX(IRQ_Num)] |= NVIC_IRQ_BIT_MASK(IRQ_Num);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_IRQSetRemove
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Interrupt request number
+ * Parameters (inout): IRQ_Set - Set to update
+ * Parameters (out): None
+ * Return value: None
+ * Description: Removes the specified IRQ from the set.
+ *****************************************************************************/
+void NVIC_IRQSetRemove(NVIC_IRQSetType *IRQ_Set, NVIC_IRQType IRQ_Num)
+{
+    IRQ_Set->Words[NVIC_IRQ_REG_INDEX(IRQ_Num)] &= ~NVIC_IRQ_BIT_MASK(IRQ_Num);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_IRQSetFromList
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_List - Array of interrupt request numbers
+ *                 IRQ_Count - Number of entries in IRQ_List
+ * Parameters (inout): None
+ * Parameters (out): IRQ_Set - Set holding exactly the listed IRQs
+ * Return value: None
+ * Description: Builds an IRQ set from a list of IRQ numbers.
+ *****************************************************************************/
+void NVIC_IRQSetFromList(NVIC_IRQSetType *IRQ_Set, const NVIC_IRQType *IRQ_List, uint8 IRQ_Count)
+{
+    uint8 i;
+    NVIC_IRQSetClear(IRQ_Set);
+    for (i = 0; i < IRQ_Count; i++) {
+        NVIC_IRQSetAdd(IRQ_Set, IRQ_List[i]);
+    }
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_IRQSetUnion
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Set_A - First operand
+ *                 Set_B - Second operand
+ * Parameters (inout): None
+ * Parameters (out): Result - Set_A | Set_B (may alias an operand)
+ * Return value: None
+ * Description: Computes the union of two IRQ sets.
+ *****************************************************************************/
+void NVIC_IRQSetUnion(NVIC_IRQSetType *Result, const NVIC_IRQSetType *Set_A, const NVIC_IRQSetType *Set_B)
+{
+    uint8 i;
+    for (i = 0; i < NVIC_IRQ_REG_COUNT; i++) {
+        Result->Words[i] = Set_A->Words[i] | Set_B->Words[i];
+    }
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_IRQSetDifference
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Set_A - First operand
+ *                 Set_B - IRQs to remove from Set_A
+ * Parameters (inout): None
+ * Parameters (out): Result - Set_A & ~Set_B (may alias an operand)
+ * Return value: None
+ * Description: Computes the IRQs that are in Set_A but not in Set_B.
+ *****************************************************************************/
+void NVIC_IRQSetDifference(NVIC_IRQSetType *Result, const NVIC_IRQSetType *Set_A, const NVIC_IRQSetType *Set_B)
+{
+    uint8 i;
+    for (i = 0; i < NVIC_IRQ_REG_COUNT; i++) {
+        Result->Words[i] = Set_A->Words[i] & ~Set_B->Words[i];
+    }
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_EnableIRQSet
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Set - IRQs to enable
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Enables every IRQ in the set. Each EN register is written at
+ *              most once and registers with no IRQ in the set are skipped.
+ *****************************************************************************/
+void NVIC_EnableIRQSet(const NVIC_IRQSetType *IRQ_Set)
+{
+    uint8 i;
+    for (i = 0; i < NVIC_IRQ_REG_COUNT; i++) {
+        if (IRQ_Set->Words[i] != 0) {
+            NVIC_ISER_REGS[i] = IRQ_Set->Words[i];
+        }
+    }
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_DisableIRQSet
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Set - IRQs to disable
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Disables every IRQ in the set. Each DIS register is written at
+ *              most once and registers with no IRQ in the set are skipped.
+ *****************************************************************************/
+void NVIC_DisableIRQSet(const NVIC_IRQSetType *IRQ_Set)
+{
+    uint8 i;
+    for (i = 0; i < NVIC_IRQ_REG_COUNT; i++) {
+        if (IRQ_Set->Words[i] != 0) {
+            NVIC_ICER_REGS[i] = IRQ_Set->Words[i];
+        }
+    }
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_SetPendingIRQSet
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Set - IRQs to pend
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Sets the pending state of every IRQ in the set. Each PEND
+ *              register is written at most once.
+ *****************************************************************************/
+void NVIC_SetPendingIRQSet(const NVIC_IRQSetType *IRQ_Set)
+{
+    uint8 i;
+    for (i = 0; i < NVIC_IRQ_REG_COUNT; i++) {
+        if (IRQ_Set->Words[i] != 0) {
+            NVIC_ISPR_REGS[i] = IRQ_Set->Words[i];
+        }
+    }
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_ApplyConfig
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Writes the register images generated from nvic_cfg.h straight
+ *              to PRI0.., SYSPRI1..3 and EN0.. as whole words.
+ *              IRQs and exceptions missing from the tables get priority 0
+ *              (the reset value), EN writes only add enables.
+ *****************************************************************************/
+void NVIC_ApplyConfig(void)
+{
+    uint8 i;
+    for (i = 0; i < NVIC_IPR_REG_COUNT; i++) {
+        ((volatile uint32 *)NVIC_IPR_REGS)[i] = NVIC_ConfigImage.Priority.Words[i];
+    }
+    for (i = 0; i < NVIC_SYSPRI_REG_COUNT; i++) {
+        NVIC_SYSPRI_REGS[i] = NVIC_ConfigImage.SystemPriority.Words[i];
+    }
+    for (i = 0; i < NVIC_IRQ_REG_COUNT; i++) {
+        NVIC_ISER_REGS[i] = NVIC_ConfigImage.EnableWords[i];
+    }
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_SaveContext
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): Context - Raw copy of the NVIC state
+ * Return value: None
+ * Description: Reads EN0.., PRI0.., SYSPRI1..3, SYSHNDCTRL and AIRCR as whole
+ *              words, e.g. before a low power mode that loses them.
+ *****************************************************************************/
+void NVIC_SaveContext(NVIC_ContextType *Context)
+{
+    uint8 i;
+    for (i = 0; i < NVIC_IRQ_REG_COUNT; i++) {
+        Context->Image.EnableWords[i] = NVIC_ISER_REGS[i];
+    }
+    for (i = 0; i < NVIC_IPR_REG_COUNT; i++) {
+        Context->Image.Priority.Words[i] = ((volatile uint32 *)NVIC_IPR_REGS)[i];
+    }
+    for (i = 0; i < NVIC_SYSPRI_REG_COUNT; i++) {
+        Context->Image.SystemPriority.Words[i] = NVIC_SYSPRI_REGS[i];
+    }
+    Context->System_Handler_Ctrl = NVIC_SYSTEM_SYSHNDCTRL;
+    Context->Interrupt_Ctrl = NVIC_AIRCR_REG;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_RestoreContext
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): Context - State captured by NVIC_SaveContext
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Replays the saved words with exceptions masked. Priorities
+ *              are written before any IRQ is enabled so no IRQ can fire at
+ *              a stale priority. The active and pending bits of SYSHNDCTRL
+ *              are left untouched. The restore is about 50 word stores.
+ *****************************************************************************/
+void NVIC_RestoreContext(const NVIC_ContextType *Context)
+{
+    uint8 i;
+    NVIC_CriticalStateType state = NVIC_EnterCritical();
+
+    for (i = 0; i < NVIC_IRQ_REG_COUNT; i++) {
+        NVIC_ICER_REGS[i] = ~Context->Image.EnableWords[i];
+    }
+    for (i = 0; i < NVIC_IPR_REG_COUNT; i++) {
+        ((volatile uint32 *)NVIC_IPR_REGS)[i] = Context->Image.Priority.Words[i];
+    }
+    for (i = 0; i < NVIC_SYSPRI_REG_COUNT; i++) {
+        NVIC_SYSPRI_REGS[i] = Context->Image.SystemPriority.Words[i];
+    }
+    NVIC_AIRCR_REG = NVIC_AIRCR_VECTKEY | (Context->Interrupt_Ctrl & NVIC_AIRCR_PRIGROUP_MASK);
+    NVIC_SYSTEM_SYSHNDCTRL = (NVIC_SYSTEM_SYSHNDCTRL & ~NVIC_SYSHNDCTRL_ENABLE_MASK)
+                           | (Context->System_Handler_Ctrl & NVIC_SYSHNDCTRL_ENABLE_MASK);
+    for (i = 0; i < NVIC_IRQ_REG_COUNT; i++) {
+        NVIC_ISER_REGS[i] = Context->Image.EnableWords[i];
+    }
+    Data_Sync_Barrier();
+
+    NVIC_ExitCritical(state);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_SetPriorityGrouping
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): Priority_Group - PRIGROUP split to program
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Programs AIRCR PRIGROUP. Only the preemption part of a priority
+ *              decides nesting, IRQs sharing it tail-chain instead of
+ *              preempting each other.
+ *****************************************************************************/
+void NVIC_SetPriorityGrouping(NVIC_PriorityGroupType Priority_Group)
+{
+    uint32 aircr = NVIC_AIRCR_REG & ~(NVIC_AIRCR_VECTKEY_MASK | NVIC_AIRCR_PRIGROUP_MASK);
+    NVIC_AIRCR_REG = aircr | NVIC_AIRCR_VECTKEY
+                   | (((uint32)Priority_Group << NVIC_AIRCR_PRIGROUP_BITS_POS) & NVIC_AIRCR_PRIGROUP_MASK);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_GetPriorityGrouping
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_PriorityGroupType - Current PRIGROUP value
+ * Description: Reads AIRCR PRIGROUP.
+ *****************************************************************************/
+NVIC_PriorityGroupType NVIC_GetPriorityGrouping(void)
+{
+    return (NVIC_PriorityGroupType)((NVIC_AIRCR_REG & NVIC_AIRCR_PRIGROUP_MASK) >> NVIC_AIRCR_PRIGROUP_BITS_POS);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_EncodePriority
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Preempt_Priority - Preemption priority
+ *                 Sub_Priority - Sub-priority
+ * Parameters (inout): None
+ * Parameters (out): Priority - Encoded priority level
+ * Return value: boolean - FALSE if the pair does not fit the implemented bits
+ * Description: Packs a (preempt, sub) pair into a priority level according to
+ *              the current PRIGROUP and NVIC_PRIORITY_BITS.
+ *****************************************************************************/
+boolean NVIC_EncodePriority(uint8 Preempt_Priority, uint8 Sub_Priority, NVIC_IRQPriorityType *Priority)
+{
+    uint8 sub_bits = NVIC_SubPriorityBits();
+    uint8 preempt_bits = NVIC_PRIORITY_BITS - sub_bits;
+
+    if ((Preempt_Priority >> preempt_bits) != 0 || (Sub_Priority >> sub_bits) != 0) {
+        return FALSE;
+    }
+    *Priority = (NVIC_IRQPriorityType)((Preempt_Priority << sub_bits) | Sub_Priority);
+    return TRUE;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_DecodePriority
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Priority - Priority level to split
+ * Parameters (inout): None
+ * Parameters (out): Preempt_Priority - Preemption priority
+ *                  Sub_Priority - Sub-priority
+ * Return value: None
+ * Description: Splits a priority level according to the current PRIGROUP.
+ *****************************************************************************/
+void NVIC_DecodePriority(NVIC_IRQPriorityType Priority, uint8 *Preempt_Priority, uint8 *Sub_Priority)
+{
+    uint8 sub_bits = NVIC_SubPriorityBits();
+
+    *Preempt_Priority = (uint8)(Priority >> sub_bits);
+    *Sub_Priority = (uint8)(Priority & ((1 << sub_bits) - 1));
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_SetGroupedPriorityIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Interrupt request number
+ *                 Preempt_Priority - Preemption priority
+ *                 Sub_Priority - Sub-priority
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - FALSE if the pair does not fit, nothing is written
+ * Description: Sets the priority of a specified IRQ from a (preempt, sub) pair.
+ *****************************************************************************/
+boolean NVIC_SetGroupedPriorityIRQ(NVIC_IRQType IRQ_Num, uint8 Preempt_Priority, uint8 Sub_Priority)
+{
+    NVIC_IRQPriorityType priority;
+
+    if (NVIC_EncodePriority(Preempt_Priority, Sub_Priority, &priority) == FALSE) {
+        return FALSE;
+    }
+    NVIC_SetPriorityIRQ(IRQ_Num, priority);
+    return TRUE;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_GetGroupedPriorityIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Interrupt request number
+ * Parameters (inout): None
+ * Parameters (out): Preempt_Priority - Preemption priority
+ *                  Sub_Priority - Sub-priority
+ * Return value: None
+ * Description: Reads the priority of a specified IRQ as a (preempt, sub) pair.
+ *****************************************************************************/
+void NVIC_GetGroupedPriorityIRQ(NVIC_IRQType IRQ_Num, uint8 *Preempt_Priority, uint8 *Sub_Priority)
+{
+    NVIC_DecodePriority(NVIC_GetPriorityIRQ(IRQ_Num), Preempt_Priority, Sub_Priority);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_SetGroupedPriorityException
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Type of exception
+ *                 Preempt_Priority - Preemption priority
+ *                 Sub_Priority - Sub-priority
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - FALSE if the exception has a fixed priority or the
+ *                         pair does not fit, nothing is written
+ * Description: Writes the SYSPRI byte lane of a system exception directly.
+ *****************************************************************************/
+boolean NVIC_SetGroupedPriorityException(NVIC_ExceptionType Exception_Num, uint8 Preempt_Priority, uint8 Sub_Priority)
+{
+    NVIC_IRQPriorityType priority;
+    uint8 byte = NVIC_EXCEPTION_SYSPRI_BYTE(Exception_Num);
+
+    if (byte == 0xFF || NVIC_EncodePriority(Preempt_Priority, Sub_Priority, &priority) == FALSE) {
+        return FALSE;
+    }
+    NVIC_SYSPRI_BYTE_REGS[byte] = (uint8)(priority << NVIC_PRIORITY_SHIFT);
+    return TRUE;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_GetGroupedPriorityException
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Type of exception
+ * Parameters (inout): None
+ * Parameters (out): Preempt_Priority - Preemption priority
+ *                  Sub_Priority - Sub-priority
+ * Return value: boolean - FALSE if the exception has a fixed priority
+ * Description: Reads the SYSPRI byte lane of a system exception as a
+ *              (preempt, sub) pair.
+ *****************************************************************************/
+boolean NVIC_GetGroupedPriorityException(NVIC_ExceptionType Exception_Num, uint8 *Preempt_Priority, uint8 *Sub_Priority)
+{
+    uint8 byte = NVIC_EXCEPTION_SYSPRI_BYTE(Exception_Num);
+
+    if (byte == 0xFF) {
+        return FALSE;
+    }
+    NVIC_DecodePriority((NVIC_IRQPriorityType)(NVIC_SYSPRI_BYTE_REGS[byte] >> NVIC_PRIORITY_SHIFT),
+                        Preempt_Priority, Sub_Priority);
+    return TRUE;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_RelocateVectorTable
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Copies the vector table VTOR currently points at into aligned
+ *              SRAM and switches VTOR to the copy with exceptions masked.
+ *****************************************************************************/
+void NVIC_RelocateVectorTable(void)
+{
+    uint32 i;
+    const volatile NVIC_HandlerType *current_table = (const volatile NVIC_HandlerType *)NVIC_VTOR_REG;
+    NVIC_CriticalStateType state = NVIC_EnterCritical();
+
+    for (i = 0; i < NVIC_VECTOR_COUNT; i++) {
+        NVIC_RamVectorTable[i] = current_table[i];
+    }
+    Data_Sync_Barrier();
+    NVIC_VTOR_REG = (uint32)NVIC_RamVectorTable;
+    Data_Sync_Barrier();
+    Inst_Sync_Barrier();
+
+    NVIC_ExitCritical(state);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_RegisterHandler
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Interrupt request number
+ *                 Handler - Function the hardware enters for this IRQ
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Writes the IRQ vector in the SRAM table with one aligned word
+ *              store, so the hardware fetches either the old or the new
+ *              handler, never a torn value. The barrier makes the next
+ *              exception entry use the new vector. NVIC_RelocateVectorTable
+ *              must have been called first.
+ *****************************************************************************/
+void NVIC_RegisterHandler(NVIC_IRQType IRQ_Num, NVIC_HandlerType Handler)
+{
+    NVIC_RamVectorTable[NVIC_IRQ_VECTOR_OFFSET + IRQ_Num] = Handler;
+    Data_Sync_Barrier();
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_RegisterExceptionHandler
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Type of exception
+ *                 Handler - Function the hardware enters for this exception
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Writes a system exception vector in the SRAM table, e.g. the
+ *              SysTick callback can be entered directly instead of going
+ *              through SysTick_Handler. The reset vector is never replaced.
+ *****************************************************************************/
+void NVIC_RegisterExceptionHandler(NVIC_ExceptionType Exception_Num, NVIC_HandlerType Handler)
+{
+    if (Exception_Num != EXCEPTION_RESET_TYPE) {
+        NVIC_RamVectorTable[NVIC_ExceptionVector[Exception_Num]] = Handler;
+        Data_Sync_Barrier();
+    }
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_EnterCritical
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_CriticalStateType - PRIMASK value before entering
+ * Description: Sets PRIMASK to mask every configurable exception. Sections
+ *              nest because each exit restores the state of its own entry.
+ *****************************************************************************/
+NVIC_CriticalStateType NVIC_EnterCritical(void)
+{
+    NVIC_CriticalStateType primask;
+    NVIC_READ_PRIMASK(primask);
+    Disable_Exceptions();
+    return primask;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_ExitCritical
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Saved_State - Value returned by NVIC_EnterCritical
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Restores PRIMASK, exceptions are unmasked only if they were
+ *              unmasked when the matching NVIC_EnterCritical was called.
+ *****************************************************************************/
+void NVIC_ExitCritical(NVIC_CriticalStateType Saved_State)
+{
+    NVIC_WRITE_PRIMASK(Saved_State);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_EnterCriticalCeiling
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Ceiling - Highest priority level to mask
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_CriticalStateType - BASEPRI value before entering
+ * Description: Masks IRQs and exceptions whose priority is Ceiling or lower
+ *              while higher priority ones keep running with no added latency.
+ *              BASEPRI_MAX only ever raises the mask, so a nested call with
+ *              a lower ceiling does not unmask anything. Priority_0 cannot be
+ *              expressed through BASEPRI, use NVIC_EnterCritical for it.
+ *****************************************************************************/
+NVIC_CriticalStateType NVIC_EnterCriticalCeiling(NVIC_IRQPriorityType Ceiling)
+{
+    NVIC_CriticalStateType basepri;
+    uint32 new_basepri = (uint32)(Ceiling & NVIC_PRIORITY_LEVEL_MASK) << NVIC_PRIORITY_SHIFT;
+    NVIC_READ_BASEPRI(basepri);
+    NVIC_WRITE_BASEPRI_MAX(new_basepri);
+    Inst_Sync_Barrier();
+    return basepri;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_ExitCriticalCeiling
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Saved_State - Value returned by NVIC_EnterCriticalCeiling
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Restores BASEPRI to the value it had before the matching
+ *              NVIC_EnterCriticalCeiling.
+ *****************************************************************************/
+void NVIC_ExitCriticalCeiling(NVIC_CriticalStateType Saved_State)
+{
+    NVIC_WRITE_BASEPRI(Saved_State);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_ConfigureSleep
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): Deep_Sleep - TRUE to enter deep sleep on WFI/WFE
+ *                 Event_On_Pending - TRUE so a pending IRQ wakes WFE even
+ *                                    while it is disabled
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Programs SCR SLEEPDEEP and SEVONPEND, SLEEPONEXIT is kept.
+ *****************************************************************************/
+void NVIC_ConfigureSleep(boolean Deep_Sleep, boolean Event_On_Pending)
+{
+    NVIC_CriticalStateType state = NVIC_EnterCritical();
+    uint32 scr = NVIC_SCR_REG & ~(NVIC_SCR_SLEEPDEEP_MASK | NVIC_SCR_SEVONPEND_MASK);
+
+    if (Deep_Sleep != FALSE) {
+        scr |= NVIC_SCR_SLEEPDEEP_MASK;
+    }
+    if (Event_On_Pending != FALSE) {
+        scr |= NVIC_SCR_SEVONPEND_MASK;
+    }
+    NVIC_SCR_REG = scr;
+    NVIC_ExitCritical(state);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_SleepOnExit
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Event driven main loop body, called from thread mode with
+ *              exceptions enabled. With SLEEPONEXIT set the core goes back
+ *              to sleep on the exception return to thread mode, so ISRs run
+ *              sleep -> ISR -> sleep with no unstacking, thread code or
+ *              restacking in between. Returns once an ISR has called
+ *              NVIC_RequestThreadWork, a request made just before the call
+ *              is never lost because the flag is checked with PRIMASK set.
+ *****************************************************************************/
+void NVIC_SleepOnExit(void)
+{
+    NVIC_WRITE_PRIMASK(1);
+    while (NVIC_ThreadWorkPending == FALSE) {
+        NVIC_SCR_REG |= NVIC_SCR_SLEEPONEXIT_MASK;
+        Data_Sync_Barrier();
+        Wait_For_Interrupt();                   /* Wakes on a pending IRQ even with PRIMASK set */
+        NVIC_WRITE_PRIMASK(0);
+        /* The pending ISR runs here and, unless it requested thread work, returns to sleep */
+        NVIC_WRITE_PRIMASK(1);
+    }
+    NVIC_ThreadWorkPending = FALSE;
+    NVIC_SCR_REG &= ~NVIC_SCR_SLEEPONEXIT_MASK;
+    NVIC_WRITE_PRIMASK(0);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_RequestThreadWork
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Leaves the sleep-on-exit mode so the next exception return to
+ *              thread mode resumes the caller of NVIC_SleepOnExit, which then
+ *              runs the queued work and calls NVIC_SleepOnExit again.
+ *****************************************************************************/
+void NVIC_RequestThreadWork(void)
+{
+    NVIC_ThreadWorkPending = TRUE;
+    NVIC_SCR_REG &= ~NVIC_SCR_SLEEPONEXIT_MASK;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_EnableException
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): Exception_Num - Type of exception to enable
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Enables a specific system or fault exception.
+ *****************************************************************************/
+void NVIC_EnableException(NVIC_ExceptionType Exception_Num)
+{
+    switch (Exception_Num) {
+    case EXCEPTION_MEM_FAULT_TYPE:
+        NVIC_SYSTEM_SYSHNDCTRL |= (1 << 16);
+        break;
+    case EXCEPTION_BUS_FAULT_TYPE:
+        NVIC_SYSTEM_SYSHNDCTRL |= (1 << 17);
+        break;
+    case EXCEPTION_USAGE_FAULT_TYPE:
+        NVIC_SYSTEM_SYSHNDCTRL |= (1 << 18);
+        break;
+    case EXCEPTION_DEBUG_MONITOR_TYPE:
+        NVIC_SYSTEM_SYSHNDCTRL |= (1 << 8);
+        break;
+    case EXCEPTION_SYSTICK_TYPE:
+        SYSTICK_CTRL_REG |= (1 << 1);
+        break;
+    default:
+        break;
+    }
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_DisableException
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): Exception_Num - Type of exception to disable
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Disables a specific system or fault exception.
+ *****************************************************************************/
+void NVIC_DisableException(NVIC_ExceptionType Exception_Num)
+{
+    switch (Exception_Num) {
+    case EXCEPTION_MEM_FAULT_TYPE:
+        NVIC_SYSTEM_SYSHNDCTRL &= ~(1 << 16);
+        break;
+    case EXCEPTION_BUS_FAULT_TYPE:
+        NVIC_SYSTEM_SYSHNDCTRL &= ~(1 << 17);
+        break;
+    case EXCEPTION_USAGE_FAULT_TYPE:
+        NVIC_SYSTEM_SYSHNDCTRL &= ~(1 << 18);
+        break;
+    case EXCEPTION_DEBUG_MONITOR_TYPE:
+        NVIC_SYSTEM_SYSHNDCTRL &= ~(1 << 8);
+        break;
+    case EXCEPTION_SYSTICK_TYPE:
+        SYSTICK_CTRL_REG &= ~(1 << 1);
+        break;
+    default:
+        break;
+    }
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_SetPriorityException
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): Exception_Num - Type of exception
+ *                 Exception_Priority - Priority to set
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Sets the priority level of a specified system or fault exception.
+ *****************************************************************************/
+void NVIC_SetPriorityException(NVIC_ExceptionType Exception_Num, NVIC_ExceptionPriorityType Exception_Priority)
+{
+    switch (Exception_Num) {
+    case EXCEPTION_MEM_FAULT_TYPE:
+        NVIC_SYSTEM_PRI1_REG &= ~MEM_FAULT_PRIORITY_MASK;
+        NVIC_SYSTEM_PRI1_REG |= (Exception_Priority << MEM_FAULT_PRIORITY_BITS_POS);
+        break;
+    case EXCEPTION_BUS_FAULT_TYPE:
+        NVIC_SYSTEM_PRI1_REG &= ~BUS_FAULT_PRIORITY_MASK;
+        NVIC_SYSTEM_PRI1_REG |= (Exception_Priority << BUS_FAULT_PRIORITY_BITS_POS);
+        break;
+    case EXCEPTION_USAGE_FAULT_TYPE:
+        NVIC_SYSTEM_PRI1_REG &= ~USAGE_FAULT_PRIORITY_MASK;
+        NVIC_SYSTEM_PRI1_REG |= (Exception_Priority << USAGE_FAULT_PRIORITY_BITS_POS);
+        break;
+    case EXCEPTION_SVC_TYPE:
+        NVIC_SYSTEM_PRI2_REG &= ~SVC_PRIORITY_MASK;
+        NVIC_SYSTEM_PRI2_REG |= (Exception_Priority << SVC_PRIORITY_BITS_POS);
+        break;
+    case EXCEPTION_DEBUG_MONITOR_TYPE:
+        NVIC_SYSTEM_PRI3_REG &= ~DEBUG_MONITOR_PRIORITY_MASK;
+        NVIC_SYSTEM_PRI3_REG |= (Exception_Priority << DEBUG_MONITOR_PRIORITY_BITS_POS);
+        break;
+    case EXCEPTION_PEND_SV_TYPE:
+        NVIC_SYSTEM_PRI3_REG &= ~PENDSV_PRIORITY_MASK;
+        NVIC_SYSTEM_PRI3_REG |= (Exception_Priority << PENDSV_PRIORITY_BITS_POS);
+        break;
+    case EXCEPTION_SYSTICK_TYPE:
+        NVIC_SYSTEM_PRI3_REG &= ~SYSTICK_PRIORITY_MASK;
+        NVIC_SYSTEM_PRI3_REG |= (Exception_Priority << SYSTICK_PRIORITY_BITS_POS);
+        break;
+    default:
+        break;
+    }
+}
@@ -1,212 +1,478 @@
-/******************************************************************************
- *
- * Module: NVIC
- *
- * File Name: NVIC.h
- *
- * Description: Header file for the ARM Cortex M4 NVIC driver
- *
- * Author: Ahmed Osama
- *
- *******************************************************************************/
-
-#ifndef NVIC_H_
-#define NVIC_H_
-
-/*******************************************************************************
- *                                Inclusions                                   *
- *******************************************************************************/
-#include"tm4c123gh6pm_registers.h"
-#include "std_types.h"
-/*******************************************************************************
- *                           Preprocessor Definitions                          *
- *******************************************************************************/
-
-#define MEM_FAULT_PRIORITY_MASK              0x000000E0
-#define MEM_FAULT_PRIORITY_BITS_POS          5
-
-#define BUS_FAULT_PRIORITY_MASK              0x0000E000
-#define BUS_FAULT_PRIORITY_BITS_POS          13
-
-#define USAGE_FAULT_PRIORITY_MASK            0x00E00000
-#define USAGE_FAULT_PRIORITY_BITS_POS        21
-
-#define SVC_PRIORITY_MASK                    0xE0000000
-#define SVC_PRIORITY_BITS_POS                29
-
-#define DEBUG_MONITOR_PRIORITY_MASK          0x000000E0
-#define DEBUG_MONITOR_PRIORITY_BITS_POS      5
-
-#define PENDSV_PRIORITY_MASK                 0x00E00000
-#define PENDSV_PRIORITY_BITS_POS             21
-
-#define SYSTICK_PRIORITY_MASK                0xE0000000
-#define SYSTICK_PRIORITY_BITS_POS            29
-
-#define MEM_FAULT_ENABLE_MASK                0x00010000
-#define BUS_FAULT_ENABLE_MASK                0x00020000
-#define USAGE_FAULT_ENABLE_MASK              0x00040000
-
-/* Enable Exceptions ... This Macro enable IRQ interrupts, Programmable Systems Exceptions and Faults by clearing the I-bit in the PRIMASK. */
-#define Enable_Exceptions()    __asm(" CPSIE I ")
-
-/* Disable Exceptions ... This Macro disable IRQ interrupts, Programmable Systems Exceptions and Faults by setting the I-bit in the PRIMASK. */
-#define Disable_Exceptions()   __asm(" CPSID I ")
-
-/* Enable Faults ... This Macro enable Faults by clearing the F-bit in the FAULTMASK */
-#define Enable_Faults()        __asm(" CPSIE F ")
-
-/* Disable Faults ... This Macro disable Faults by setting the F-bit in the FAULTMASK */
-#define Disable_Faults()       __asm(" CPSID F ")
-
-
-
-/*******************************************************************************
- *                           Data Types Declarations                           *
- *******************************************************************************/
-typedef enum {
-    GPIO_PORT_A=0,                    // GPIO Port A
-    GPIO_PORT_B,                        // GPIO Port B
-    GPIO_PORT_C,                        // GPIO Port C
-    GPIO_PORT_D,                        // GPIO Port D
-    GPIO_PORT_E,                        // GPIO Port E
-    UART0_RXTX,                         // UART0 Rx and Tx
-    UART1_RXTX,                         // UART1 Rx and Tx
-    SSI0_RXTX,                          // SSI0 Rx and Tx
-    I2C0_MASTER_SLAVE,                  // I2C0 Master and Slave
-    PWM_FAULT,                          // PWM Fault
-    PWM_GENERATOR_0,                    // PWM Generator 0
-    PWM_GENERATOR_1,                    // PWM Generator 1
-    PWM_GENERATOR_2,                    // PWM Generator 2
-    QUADRATURE_ENCODER_0,               // Quadrature Encoder 0
-    ADC_SEQUENCE_0,                     // ADC Sequence 0
-    ADC_SEQUENCE_1,                     // ADC Sequence 1
-    ADC_SEQUENCE_2,                     // ADC Sequence 2
-    ADC_SEQUENCE_3,                     // ADC Sequence 3
-    WATCHDOG_TIMER,                     // Watchdog timer
-    TIMER_0_SUBTIMER_A,                 // Timer 0 subtimer A
-    TIMER_0_SUBTIMER_B,                 // Timer 0 subtimer B
-    TIMER_1_SUBTIMER_A,                 // Timer 1 subtimer A
-    TIMER_1_SUBTIMER_B,                 // Timer 1 subtimer B
-    TIMER_2_SUBTIMER_A,                 // Timer 2 subtimer A
-    TIMER_2_SUBTIMER_B,                 // Timer 2 subtimer B
-    ANALOG_COMPARATOR_0,                // Analog Comparator 0
-    ANALOG_COMPARATOR_1,                // Analog Comparator 1
-    ANALOG_COMPARATOR_2,                // Analog Comparator 2
-    SYSTEM_CONTROL,                     // System Control (PLL, OSC, BO)
-    FLASH_CONTROL,                      // FLASH Control
-    GPIO_PORT_F,                        // GPIO Port F
-    GPIO_PORT_G,                        // GPIO Port G
-    GPIO_PORT_H,                        // GPIO Port H
-    UART2_RXTX,                         // UART2 Rx and Tx
-    SSI1_RXTX,                          // SSI1 Rx and Tx
-    TIMER_3_SUBTIMER_A,                 // Timer 3 subtimer A
-    TIMER_3_SUBTIMER_B,                 // Timer 3 subtimer B
-    I2C1_MASTER_SLAVE,                  // I2C1 Master and Slave
-    QUADRATURE_ENCODER_1,               // Quadrature Encoder 1
-    CAN0,                               // CAN0
-    CAN1,                               // CAN1
-    HIBERNATE,                          // Hibernate
-    USB0,                               // USB0
-    PWM_GENERATOR_3,                    // PWM Generator 3
-    UDMA_SOFTWARE_TRANSFER,             // uDMA Software Transfer
-    UDMA_ERROR,                         // uDMA Error
-    ADC1_SEQUENCE_0,                    // ADC1 Sequence 0
-    ADC1_SEQUENCE_1,                    // ADC1 Sequence 1
-    ADC1_SEQUENCE_2,                    // ADC1 Sequence 2
-    ADC1_SEQUENCE_3,                    // ADC1 Sequence 3
-    GPIO_PORT_J,                        // GPIO Port J
-    GPIO_PORT_K,                        // GPIO Port K
-    GPIO_PORT_L,                        // GPIO Port L
-    SSI2_RXTX,                          // SSI2 Rx and Tx
-    SSI3_RXTX,                          // SSI3 Rx and Tx
-    UART3_RXTX,                         // UART3 Rx and Tx
-    UART4_RXTX,                         // UART4 Rx and Tx
-    UART5_RXTX,                         // UART5 Rx and Tx
-    UART6_RXTX,                         // UART6 Rx and Tx
-    UART7_RXTX,                         // UART7 Rx and Tx
-    I2C2_MASTER_SLAVE,                  // I2C2 Master and Slave
-    I2C3_MASTER_SLAVE,                  // I2C3 Master and Slave
-    TIMER_4_SUBTIMER_A,                 // Timer 4 subtimer A
-    TIMER_4_SUBTIMER_B,                 // Timer 4 subtimer B
-    I2C4_MASTER_SLAVE,                  // I2C4 Master and Slave
-    I2C5_MASTER_SLAVE,                  // I2C5 Master and Slave
-    GPIO_PORT_M,                        // GPIO Port M
-    GPIO_PORT_N,                        // GPIO Port N
-    QUADRATURE_ENCODER_2,               // Quadrature Encoder 2
-    GPIO_PORT_P,                        // GPIO Port P (Summary or P0)
-    GPIO_PORT_Q,                        // GPIO Port Q (Summary or Q0)
-    GPIO_PORT_R,                        // GPIO Port R
-    GPIO_PORT_S,                        // GPIO Port S
-    PWM_1_GENERATOR_0,                  // PWM 1 Generator 0
-    PWM_1_GENERATOR_1,                  // PWM 1 Generator 1
-    PWM_1_GENERATOR_2,                  // PWM 1 Generator 2
-    PWM_1_GENERATOR_3,                  // PWM 1 Generator 3
-    PWM_1_FAULT                         // PWM 1 Fault
-} NVIC_IRQType;
-
-typedef enum
-{
-    EXCEPTION_RESET_TYPE,
-    EXCEPTION_NMI_TYPE,
-    EXCEPTION_HARD_FAULT_TYPE,
-    EXCEPTION_MEM_FAULT_TYPE,
-    EXCEPTION_BUS_FAULT_TYPE,
-    EXCEPTION_USAGE_FAULT_TYPE,
-    EXCEPTION_SVC_TYPE,
-    EXCEPTION_DEBUG_MONITOR_TYPE,
-    EXCEPTION_PEND_SV_TYPE,
-    EXCEPTION_SYSTICK_TYPE
-}NVIC_ExceptionType;
-
-typedef enum {
-    Priority_exception_0,
-    Priority_exception_1,
-    Priority_exception_2,
-    Priority_exception_3,
-    Priority_exception_4,
-    Priority_exception_5,
-    Priority_exception_6,
-    Priority_exception_7,
-} NVIC_ExceptionPriorityType;
-
-typedef enum {
-    Priority_0,
-    Priority_1,
-    Priority_2,
-    Priority_3,
-    Priority_4,
-    Priority_5,
-    Priority_6,
-    Priority_7,
-} NVIC_IRQPriorityType;
-/*******************************************************************************
- *                            Functions Prototypes                             *
- *******************************************************************************/
-// Enables a specific IRQ by number
-void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num);
-
-// Disables a specific IRQ by number
-void NVIC_DisableIRQ(NVIC_IRQType IRQ_Num);
-
-// Sets the priority of a specific IRQ
-void NVIC_SetPriorityIRQ(NVIC_IRQType IRQ_Num, NVIC_IRQPriorityType IRQ_Priority);
-
-
-// Enables a specific ARM system or fault exception
-void NVIC_EnableException(NVIC_ExceptionType Exception_Num);
-
-// Disables a specific ARM system or fault exception
-void NVIC_DisableException(NVIC_ExceptionType Exception_Num);
-
-// Sets the priority value for a specific ARM system or fault exception
-void NVIC_SetPriorityException(NVIC_ExceptionType Exception_Num, NVIC_ExceptionPriorityType Exception_Priority);
-
-
-
-
-/************************************************************************************
- *                                 End of File                                      *
- ************************************************************************************/
-
-#endif /* NVIC_H_ */
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC.h
+ *
+ * Description: Header file for the ARM Cortex M4 NVIC driver
+ *
+ * Author: Ahmed Osama
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_H_
+#define NVIC_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include"tm4c123gh6pm_registers.h"
+#include "std_types.h"
+#include "nvic_device.h"
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Number of priority bits implemented by the part (nvic_device.h), the priority lives in the upper bits of each byte lane */
+#define NVIC_PRIORITY_SHIFT                  (8 - NVIC_PRIORITY_BITS)
+#define NVIC_PRIORITY_LEVEL_MASK             ((1 << NVIC_PRIORITY_BITS) - 1)
+
+/* Position and mask of the priority field living in byte lane LANE of a 32-bit priority register */
+#define NVIC_PRIORITY_FIELD_POS(LANE)        (((LANE) * 8) + NVIC_PRIORITY_SHIFT)
+#define NVIC_PRIORITY_FIELD_MASK(LANE)       ((uint32)NVIC_PRIORITY_LEVEL_MASK << NVIC_PRIORITY_FIELD_POS(LANE))
+
+#define MEM_FAULT_PRIORITY_MASK              NVIC_PRIORITY_FIELD_MASK(0)
+#define MEM_FAULT_PRIORITY_BITS_POS          NVIC_PRIORITY_FIELD_POS(0)
+
+#define BUS_FAULT_PRIORITY_MASK              NVIC_PRIORITY_FIELD_MASK(1)
+#define BUS_FAULT_PRIORITY_BITS_POS          NVIC_PRIORITY_FIELD_POS(1)
+
+#define USAGE_FAULT_PRIORITY_MASK            NVIC_PRIORITY_FIELD_MASK(2)
+#define USAGE_FAULT_PRIORITY_BITS_POS        NVIC_PRIORITY_FIELD_POS(2)
+
+#define SVC_PRIORITY_MASK                    NVIC_PRIORITY_FIELD_MASK(3)
+#define SVC_PRIORITY_BITS_POS                NVIC_PRIORITY_FIELD_POS(3)
+
+#define DEBUG_MONITOR_PRIORITY_MASK          NVIC_PRIORITY_FIELD_MASK(0)
+#define DEBUG_MONITOR_PRIORITY_BITS_POS      NVIC_PRIORITY_FIELD_POS(0)
+
+#define PENDSV_PRIORITY_MASK                 NVIC_PRIORITY_FIELD_MASK(2)
+#define PENDSV_PRIORITY_BITS_POS             NVIC_PRIORITY_FIELD_POS(2)
+
+#define SYSTICK_PRIORITY_MASK                NVIC_PRIORITY_FIELD_MASK(3)
+#define SYSTICK_PRIORITY_BITS_POS            NVIC_PRIORITY_FIELD_POS(3)
+
+#define MEM_FAULT_ENABLE_MASK                0x00010000
+#define BUS_FAULT_ENABLE_MASK                0x00020000
+#define USAGE_FAULT_ENABLE_MASK              0x00040000
+#define NVIC_SYSHNDCTRL_ENABLE_MASK          (MEM_FAULT_ENABLE_MASK | BUS_FAULT_ENABLE_MASK | USAGE_FAULT_ENABLE_MASK)
+
+/* NVIC register banks as arrays of 32-bit words, indexed by (IRQ_Num >> 5).
+ * Each bank may be defined before including this file to point it at a register stub (host builds). */
+#ifndef NVIC_ISER_REGS
+#define NVIC_ISER_REGS                       ((volatile uint32 *)0xE000E100)   /* EN0 .. EN4   */
+#endif
+
+#ifndef NVIC_ICER_REGS
+#define NVIC_ICER_REGS                       ((volatile uint32 *)0xE000E180)   /* DIS0 .. DIS4 */
+#endif
+
+#ifndef NVIC_ISPR_REGS
+#define NVIC_ISPR_REGS                       ((volatile uint32 *)0xE000E200)   /* PEND0 .. PEND4 */
+#endif
+
+#ifndef NVIC_ICPR_REGS
+#define NVIC_ICPR_REGS                       ((volatile uint32 *)0xE000E280)   /* UNPEND0 .. UNPEND4 */
+#endif
+
+#ifndef NVIC_IABR_REGS
+#define NVIC_IABR_REGS                       ((volatile uint32 *)0xE000E300)   /* ACTIVE0 .. ACTIVE4 */
+#endif
+
+/* Software Trigger Interrupt register, writing an IRQ number pends that IRQ */
+#ifndef NVIC_STIR_REG
+#define NVIC_STIR_REG                        (*((volatile uint32 *)0xE000EF00))
+#endif
+
+/* Number of 32-bit words in each per-IRQ bank, e.g. EN0 .. EN4 for the 139 lines of the TM4C123 */
+#define NVIC_IRQ_REG_COUNT                   ((NVIC_DEVICE_IRQ_LINES + 31) / 32)
+
+/* Number of 32-bit words of PRI registers (PRI0 .. PRIn), four IRQ byte lanes each */
+#define NVIC_IPR_REG_COUNT                   ((NVIC_DEVICE_IRQ_LINES + 3) / 4)
+
+/* Interrupt Priority registers (PRI0 .. PRI39) as an array of bytes, one byte lane per IRQ */
+#ifndef NVIC_IPR_REGS
+#define NVIC_IPR_REGS                        ((volatile uint8 *)0xE000E400)
+#endif
+
+/* System Handler Priority registers (SYSPRI1 .. SYSPRI3) as an array of 32-bit words */
+#ifndef NVIC_SYSPRI_REGS
+#define NVIC_SYSPRI_REGS                     ((volatile uint32 *)0xE000ED18)
+#endif
+#define NVIC_SYSPRI_REG_COUNT                3
+
+/* Byte offset of a configurable system exception inside SYSPRI1 .. SYSPRI3, 0xFF for fixed priority exceptions */
+#define NVIC_EXCEPTION_SYSPRI_BYTE(EXCEPTION)                    \
+    ((EXCEPTION) == EXCEPTION_MEM_FAULT_TYPE     ? 0  :          \
+     (EXCEPTION) == EXCEPTION_BUS_FAULT_TYPE     ? 1  :          \
+     (EXCEPTION) == EXCEPTION_USAGE_FAULT_TYPE   ? 2  :          \
+     (EXCEPTION) == EXCEPTION_SVC_TYPE           ? 7  :          \
+     (EXCEPTION) == EXCEPTION_DEBUG_MONITOR_TYPE ? 8  :          \
+     (EXCEPTION) == EXCEPTION_PEND_SV_TYPE       ? 10 :          \
+     (EXCEPTION) == EXCEPTION_SYSTICK_TYPE       ? 11 : 0xFF)
+
+/* SYSPRI1 .. SYSPRI3 as an array of bytes, indexed by NVIC_EXCEPTION_SYSPRI_BYTE */
+#define NVIC_SYSPRI_BYTE_REGS                ((volatile uint8 *)NVIC_SYSPRI_REGS)
+
+/* Application Interrupt and Reset Control register, writes must carry VECTKEY */
+#ifndef NVIC_AIRCR_REG
+#define NVIC_AIRCR_REG                       (*((volatile uint32 *)0xE000ED0C))
+#endif
+#define NVIC_AIRCR_VECTKEY                   0x05FA0000
+#define NVIC_AIRCR_VECTKEY_MASK              0xFFFF0000
+#define NVIC_AIRCR_PRIGROUP_MASK             0x00000700
+#define NVIC_AIRCR_PRIGROUP_BITS_POS         8
+
+/* Interrupt Control and State register, pends PendSV and pends/un-pends the SysTick exception */
+#ifndef NVIC_ICSR_REG
+#define NVIC_ICSR_REG                        (*((volatile uint32 *)0xE000ED04))
+#endif
+#define NVIC_ICSR_PENDSVSET_MASK             0x10000000
+#define NVIC_ICSR_PENDSTSET_MASK             0x04000000
+#define NVIC_ICSR_PENDSTCLR_MASK             0x02000000
+
+/* System Control register, sleep behaviour of WFI/WFE */
+#ifndef NVIC_SCR_REG
+#define NVIC_SCR_REG                         (*((volatile uint32 *)0xE000ED10))
+#endif
+#define NVIC_SCR_SLEEPONEXIT_MASK            0x00000002
+#define NVIC_SCR_SLEEPDEEP_MASK              0x00000004
+#define NVIC_SCR_SEVONPEND_MASK              0x00000010
+
+/* Vector Table Offset register */
+#ifndef NVIC_VTOR_REG
+#define NVIC_VTOR_REG                        (*((volatile uint32 *)0xE000ED08))
+#endif
+
+/* Vector table: initial SP + 15 system exception vectors + one vector per IRQ line.
+ * VTOR needs the table aligned to the next power of two of its size (155 words = 620 bytes on the TM4C123). */
+#define NVIC_VECTOR_COUNT                    (16 + NVIC_DEVICE_IRQ_LINES)
+#define NVIC_VECTOR_TABLE_ALIGN              (((NVIC_VECTOR_COUNT * 4) <= 128) ? 128 :  \
+                                              ((NVIC_VECTOR_COUNT * 4) <= 256) ? 256 :  \
+                                              ((NVIC_VECTOR_COUNT * 4) <= 512) ? 512 : 1024)
+#define NVIC_IRQ_VECTOR_OFFSET               16
+
+/* Section holding handlers that must run from zero wait state SRAM, the linker script must copy it like .data */
+#ifndef NVIC_RAMFUNC_SECTION
+#define NVIC_RAMFUNC_SECTION                 ".ramfunc"
+#endif
+
+/* Place a handler definition in SRAM: void NVIC_RAM_HANDLER UART0_Handler(void) { ... } */
+#define NVIC_RAM_HANDLER                     __attribute__((section(NVIC_RAMFUNC_SECTION), noinline))
+
+/* Word index and bit mask of an IRQ inside a 32-bit per-IRQ bank (EN, DIS, PEND, UNPEND, ACTIVE) */
+#define NVIC_IRQ_REG_INDEX(IRQ)              ((uint32)(IRQ) >> 5)
+#define NVIC_IRQ_BIT_MASK(IRQ)               ((uint32)1 << ((uint32)(IRQ) & 0x1F))
+
+/* Core instructions and special registers. Each one may be defined before including this file
+ * so that a host build can model PRIMASK, BASEPRI and IPSR in plain variables. */
+
+/* Enable Exceptions ... This Macro enable IRQ interrupts, Programmable Systems Exceptions and Faults by clearing the I-bit in the PRIMASK. */
+#ifndef Enable_Exceptions
+#define Enable_Exceptions()    __asm(" CPSIE I ")
+#endif
+
+/* Disable Exceptions ... This Macro disable IRQ interrupts, Programmable Systems Exceptions and Faults by setting the I-bit in the PRIMASK. */
+#ifndef Disable_Exceptions
+#define Disable_Exceptions()   __asm(" CPSID I ")
+#endif
+
+/* Enable Faults ... This Macro enable Faults by clearing the F-bit in the FAULTMASK */
+#ifndef Enable_Faults
+#define Enable_Faults()        __asm(" CPSIE F ")
+#endif
+
+/* Disable Faults ... This Macro disable Faults by setting the F-bit in the FAULTMASK */
+#ifndef Disable_Faults
+#define Disable_Faults()       __asm(" CPSID F ")
+#endif
+
+/* Go to low power mode while waiting for the next interrupt */
+#ifndef Wait_For_Interrupt
+#define Wait_For_Interrupt()   __asm(" WFI ")
+#endif
+
+/* Data Synchronization and Instruction Synchronization barriers, used after writes to PRIMASK/BASEPRI */
+#ifndef Data_Sync_Barrier
+#define Data_Sync_Barrier()    __asm(" DSB ")
+#endif
+#ifndef Inst_Sync_Barrier
+#define Inst_Sync_Barrier()    __asm(" ISB ")
+#endif
+
+/* Data Memory Barrier, also stops the compiler from moving memory accesses across it */
+#ifndef Data_Memory_Barrier
+#define Data_Memory_Barrier()  __asm volatile (" DMB " ::: "memory")
+#endif
+
+/* PRIMASK, BASEPRI and IPSR accessors, VALUE is a uint32 lvalue for the reads */
+#ifndef NVIC_READ_PRIMASK
+#define NVIC_READ_PRIMASK(VALUE)             __asm volatile (" MRS %0, PRIMASK " : "=r" (VALUE) :: "memory")
+#endif
+#ifndef NVIC_WRITE_PRIMASK
+#define NVIC_WRITE_PRIMASK(VALUE)            __asm volatile (" MSR PRIMASK, %0 " :: "r" (VALUE) : "memory")
+#endif
+#ifndef NVIC_READ_BASEPRI
+#define NVIC_READ_BASEPRI(VALUE)             __asm volatile (" MRS %0, BASEPRI " : "=r" (VALUE) :: "memory")
+#endif
+#ifndef NVIC_WRITE_BASEPRI
+#define NVIC_WRITE_BASEPRI(VALUE)            __asm volatile (" MSR BASEPRI, %0 " :: "r" (VALUE) : "memory")
+#endif
+/* Only raises the mask: ignored when VALUE is 0 or does not mask more than the current BASEPRI */
+#ifndef NVIC_WRITE_BASEPRI_MAX
+#define NVIC_WRITE_BASEPRI_MAX(VALUE)        __asm volatile (" MSR BASEPRI_MAX, %0 " :: "r" (VALUE) : "memory")
+#endif
+/* Exception number being serviced, IRQ n is exception n + NVIC_IRQ_VECTOR_OFFSET */
+#ifndef NVIC_READ_IPSR
+#define NVIC_READ_IPSR(VALUE)                __asm volatile (" MRS %0, IPSR " : "=r" (VALUE))
+#endif
+
+
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Number of IRQ lines listed in NVIC_IRQType */
+#define NVIC_IRQ_COUNT                       (NVIC_DEVICE_LAST_IRQ + 1)
+
+/* Set of IRQ lines with the same word layout as the EN/DIS/PEND banks */
+typedef struct
+{
+    uint32 Words[NVIC_IRQ_REG_COUNT];
+} NVIC_IRQSetType;
+
+typedef enum
+{
+    EXCEPTION_RESET_TYPE,
+    EXCEPTION_NMI_TYPE,
+    EXCEPTION_HARD_FAULT_TYPE,
+    EXCEPTION_MEM_FAULT_TYPE,
+    EXCEPTION_BUS_FAULT_TYPE,
+    EXCEPTION_USAGE_FAULT_TYPE,
+    EXCEPTION_SVC_TYPE,
+    EXCEPTION_DEBUG_MONITOR_TYPE,
+    EXCEPTION_PEND_SV_TYPE,
+    EXCEPTION_SYSTICK_TYPE
+}NVIC_ExceptionType;
+
+typedef enum {
+    Priority_exception_0,
+    Priority_exception_1,
+    Priority_exception_2,
+    Priority_exception_3,
+    Priority_exception_4,
+    Priority_exception_5,
+    Priority_exception_6,
+    Priority_exception_7,
+#if NVIC_PRIORITY_BITS > 3
+    Priority_exception_8,
+    Priority_exception_9,
+    Priority_exception_10,
+    Priority_exception_11,
+    Priority_exception_12,
+    Priority_exception_13,
+    Priority_exception_14,
+    Priority_exception_15,
+#endif
+} NVIC_ExceptionPriorityType;
+
+typedef enum {
+    Priority_0,
+    Priority_1,
+    Priority_2,
+    Priority_3,
+    Priority_4,
+    Priority_5,
+    Priority_6,
+    Priority_7,
+#if NVIC_PRIORITY_BITS > 3
+    Priority_8,
+    Priority_9,
+    Priority_10,
+    Priority_11,
+    Priority_12,
+    Priority_13,
+    Priority_14,
+    Priority_15,
+#endif
+} NVIC_IRQPriorityType;
+/* AIRCR PRIGROUP value, the split point between preemption (x) and sub-priority (y) bits of a priority byte */
+typedef enum {
+    PRIGROUP_0,                         // xxxxxxx.y
+    PRIGROUP_1,                         // xxxxxx.yy
+    PRIGROUP_2,                         // xxxxx.yyy
+    PRIGROUP_3,                         // xxxx.yyyy
+    PRIGROUP_4,                         // xxx.yyyyy
+    PRIGROUP_5,                         // xx.yyyyyy
+    PRIGROUP_6,                         // x.yyyyyyy
+    PRIGROUP_7                          // .yyyyyyyy
+} NVIC_PriorityGroupType;
+
+/* Interrupt or exception handler entered directly from the vector table */
+typedef void (*NVIC_HandlerType)(void);
+
+/* Saved PRIMASK or BASEPRI value returned when entering a critical section */
+typedef uint32 NVIC_CriticalStateType;
+
+/* Register images generated at compile time from the tables in nvic_cfg.h */
+typedef struct
+{
+    uint32 EnableWords[NVIC_IRQ_REG_COUNT];
+    union
+    {
+        uint8  Bytes[NVIC_IPR_REG_COUNT * 4];
+        uint32 Words[NVIC_IPR_REG_COUNT];
+    } Priority;
+    union
+    {
+        uint8  Bytes[NVIC_SYSPRI_REG_COUNT * 4];
+        uint32 Words[NVIC_SYSPRI_REG_COUNT];
+    } SystemPriority;
+} NVIC_ConfigImageType;
+
+/* Raw NVIC state captured by NVIC_SaveContext */
+typedef struct
+{
+    NVIC_ConfigImageType Image;         /* EN, PRI and SYSPRI words */
+    uint32 System_Handler_Ctrl;         /* SYSHNDCTRL, only the fault enables are restored */
+    uint32 Interrupt_Ctrl;              /* AIRCR, only PRIGROUP is restored */
+} NVIC_ContextType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+// Enables a specific IRQ by number
+void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num);
+
+// Disables a specific IRQ by number
+void NVIC_DisableIRQ(NVIC_IRQType IRQ_Num);
+
+// Sets the priority of a specific IRQ
+void NVIC_SetPriorityIRQ(NVIC_IRQType IRQ_Num, NVIC_IRQPriorityType IRQ_Priority);
+
+// Returns the priority currently programmed for a specific IRQ
+NVIC_IRQPriorityType NVIC_GetPriorityIRQ(NVIC_IRQType IRQ_Num);
+
+// Sets the pending state of a specific IRQ
+void NVIC_SetPending(NVIC_IRQType IRQ_Num);
+
+// Clears the pending state of a specific IRQ
+void NVIC_ClearPending(NVIC_IRQType IRQ_Num);
+
+// Returns TRUE if a specific IRQ is pending
+boolean NVIC_IsPending(NVIC_IRQType IRQ_Num);
+
+// Returns TRUE if a specific IRQ is active (its handler is running or preempted)
+boolean NVIC_IsActive(NVIC_IRQType IRQ_Num);
+
+// Pends a specific IRQ through the Software Trigger Interrupt register
+void NVIC_TriggerIRQ(NVIC_IRQType IRQ_Num);
+
+// Empties an IRQ set
+void NVIC_IRQSetClear(NVIC_IRQSetType *IRQ_Set);
+
+// Adds a specific IRQ to an IRQ set
+void NVIC_IRQSetAdd(NVIC_IRQSetType *IRQ_Set, NVIC_IRQType IRQ_Num);
+
+// Removes a specific IRQ from an IRQ set
+void NVIC_IRQSetRemove(NVIC_IRQSetType *IRQ_Set, NVIC_IRQType IRQ_Num);
+
+// Builds an IRQ set from a list of IRQ numbers
+void NVIC_IRQSetFromList(NVIC_IRQSetType *IRQ_Set, const NVIC_IRQType *IRQ_List, uint8 IRQ_Count);
+
+// Result = Set_A | Set_B
+void NVIC_IRQSetUnion(NVIC_IRQSetType *Result, const NVIC_IRQSetType *Set_A, const NVIC_IRQSetType *Set_B);
+
+// Result = Set_A & ~Set_B
+void NVIC_IRQSetDifference(NVIC_IRQSetType *Result, const NVIC_IRQSetType *Set_A, const NVIC_IRQSetType *Set_B);
+
+// Enables every IRQ in a set, one store per non-empty EN register
+void NVIC_EnableIRQSet(const NVIC_IRQSetType *IRQ_Set);
+
+// Disables every IRQ in a set, one store per non-empty DIS register
+void NVIC_DisableIRQSet(const NVIC_IRQSetType *IRQ_Set);
+
+// Pends every IRQ in a set, one store per non-empty PEND register
+void NVIC_SetPendingIRQSet(const NVIC_IRQSetType *IRQ_Set);
+
+// Writes the compile-time configuration images (priorities, then enables) to the NVIC
+void NVIC_ApplyConfig(void);
+
+// Captures the IRQ enables, all priorities, PRIGROUP and fault enables as raw words
+void NVIC_SaveContext(NVIC_ContextType *Context);
+
+// Writes back a context captured by NVIC_SaveContext, IRQs enabled since the save are disabled
+void NVIC_RestoreContext(const NVIC_ContextType *Context);
+
+// Sets the AIRCR PRIGROUP split between preemption priority and sub-priority
+void NVIC_SetPriorityGrouping(NVIC_PriorityGroupType Priority_Group);
+
+// Returns the current AIRCR PRIGROUP value
+NVIC_PriorityGroupType NVIC_GetPriorityGrouping(void);
+
+// Encodes a (preempt, sub) pair into a priority level for the current grouping, returns FALSE if the pair does not fit
+boolean NVIC_EncodePriority(uint8 Preempt_Priority, uint8 Sub_Priority, NVIC_IRQPriorityType *Priority);
+
+// Splits a priority level into its (preempt, sub) pair for the current grouping
+void NVIC_DecodePriority(NVIC_IRQPriorityType Priority, uint8 *Preempt_Priority, uint8 *Sub_Priority);
+
+// Sets the priority of a specific IRQ from a (preempt, sub) pair, returns FALSE if the pair does not fit
+boolean NVIC_SetGroupedPriorityIRQ(NVIC_IRQType IRQ_Num, uint8 Preempt_Priority, uint8 Sub_Priority);
+
+// Reads the priority of a specific IRQ as a (preempt, sub) pair
+void NVIC_GetGroupedPriorityIRQ(NVIC_IRQType IRQ_Num, uint8 *Preempt_Priority, uint8 *Sub_Priority);
+
+// Sets the priority of a configurable system exception from a (preempt, sub) pair, returns FALSE if invalid
+boolean NVIC_SetGroupedPriorityException(NVIC_ExceptionType Exception_Num, uint8 Preempt_Priority, uint8 Sub_Priority);
+
+// Reads the priority of a configurable system exception as a (preempt, sub) pair, returns FALSE if it has a fixed priority
+boolean NVIC_GetGroupedPriorityException(NVIC_ExceptionType Exception_Num, uint8 *Preempt_Priority, uint8 *Sub_Priority);
+
+// Copies the active vector table to aligned SRAM and points VTOR at it
+void NVIC_RelocateVectorTable(void);
+
+// Installs the handler of a specific IRQ in the SRAM vector table
+void NVIC_RegisterHandler(NVIC_IRQType IRQ_Num, NVIC_HandlerType Handler);
+
+// Installs the handler of a specific ARM system or fault exception in the SRAM vector table
+void NVIC_RegisterExceptionHandler(NVIC_ExceptionType Exception_Num, NVIC_HandlerType Handler);
+
+// Masks every configurable exception (PRIMASK) and returns the previous mask state
+NVIC_CriticalStateType NVIC_EnterCritical(void);
+
+// Restores the PRIMASK state returned by the matching NVIC_EnterCritical
+void NVIC_ExitCritical(NVIC_CriticalStateType Saved_State);
+
+// Masks only IRQs/exceptions at the Ceiling priority level or lower (BASEPRI) and returns the previous BASEPRI
+NVIC_CriticalStateType NVIC_EnterCriticalCeiling(NVIC_IRQPriorityType Ceiling);
+
+// Restores the BASEPRI value returned by the matching NVIC_EnterCriticalCeiling
+void NVIC_ExitCriticalCeiling(NVIC_CriticalStateType Saved_State);
+
+// Selects sleep or deep sleep for WFI and whether pending disabled IRQs wake WFE (SEVONPEND)
+void NVIC_ConfigureSleep(boolean Deep_Sleep, boolean Event_On_Pending);
+
+// Runs every interrupt straight from sleep (SLEEPONEXIT) and returns once an ISR called NVIC_RequestThreadWork
+void NVIC_SleepOnExit(void);
+
+// Called from an ISR that queued thread level work, makes its exception return go back to NVIC_SleepOnExit's caller
+void NVIC_RequestThreadWork(void);
+
+// Enables a specific ARM system or fault exception
+void NVIC_EnableException(NVIC_ExceptionType Exception_Num);
+
+// Disables a specific ARM system or fault exception
+void NVIC_DisableException(NVIC_ExceptionType Exception_Num);
+
+// Sets the priority value for a specific ARM system or fault exception
+void NVIC_SetPriorityException(NVIC_ExceptionType Exception_Num, NVIC_ExceptionPriorityType Exception_Priority);
+
+
+
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_H_ */
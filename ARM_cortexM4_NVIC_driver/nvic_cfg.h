@@ -0,0 +1,39 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: nvic_cfg.h
+ *
+ * Description: Static interrupt configuration tables for the ARM Cortex M4 NVIC driver
+ *
+ * Author: Ahmed Osama
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_CFG_H_
+#define NVIC_CFG_H_
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* IRQ table, one ENTRY(NVIC_IRQType, NVIC_IRQPriorityType, enabled at startup TRUE/FALSE) per IRQ.
+ * Entries must use the NVIC_IRQType names so that duplicates are caught at compile time.
+ * Example:
+ *     ENTRY(UART0_RXTX,         Priority_2, TRUE)  \
+ *     ENTRY(TIMER_0_SUBTIMER_A, Priority_1, FALSE) \
+ */
+#define NVIC_CFG_IRQ_TABLE(ENTRY)
+
+/* System exception table, one ENTRY(NVIC_ExceptionType, NVIC_ExceptionPriorityType) per exception.
+ * Only exceptions with a configurable priority are accepted.
+ * Example:
+ *     ENTRY(EXCEPTION_SYSTICK_TYPE, Priority_exception_3) \
+ */
+#define NVIC_CFG_EXCEPTION_TABLE(ENTRY)
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_CFG_H_ */
@@ -0,0 +1,312 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: nvic_coalesce.c
+ *
+ * Description: Source file for the interrupt coalescing and batched handler dispatch
+ *
+ * Author: Ahmed Osama
+ *
+ ******************************************************************************/
+#include "nvic_coalesce.h"
+#include "nvic_profiler.h"
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static NVIC_CoalesceType *NVIC_CoalesceByIRQ[NVIC_IRQ_COUNT];
+static NVIC_CoalesceType *NVIC_CoalesceList = NULL_PTR;
+static volatile uint32 NVIC_CoalesceTicks;
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+/* Stamps the oldest undelivered event of a batch for the timeout and the latency statistics */
+static void NVIC_CoalesceStamp(NVIC_CoalesceType *Coalesce)
+{
+    Coalesce->First_Tick = NVIC_CoalesceTicks;
+    Coalesce->First_Cycles = NVIC_DWT_CYCCNT_REG;
+    Coalesce->Timeout_Pended = FALSE;
+}
+
+/* Common vector for coalescer IRQs, finds the coalescer from IPSR and hands its events over in batches */
+static void NVIC_CoalesceDispatch(void)
+{
+    NVIC_EventType events[NVIC_COALESCE_MAX_BATCH];
+    NVIC_CoalesceType *coalesce;
+    uint32 first;
+    uint32 latency;
+    uint32 count;
+    uint32 irq;
+
+    NVIC_READ_IPSR(irq);
+    coalesce = NVIC_CoalesceByIRQ[irq - NVIC_IRQ_VECTOR_OFFSET];
+    for (;;) {
+        /* The producer only restamps an empty queue, so the stamp belongs to the events popped next */
+        first = coalesce->First_Cycles;
+        count = NVIC_SPSCQueuePopBatch(&coalesce->Queue, events, NVIC_COALESCE_MAX_BATCH);
+        if (count == 0) {
+            break;
+        }
+        latency = NVIC_DWT_CYCCNT_REG - first;
+        coalesce->Stats.Batches++;
+        coalesce->Stats.Total_Latency_Cycles += latency;
+        if (latency > coalesce->Stats.Max_Latency_Cycles) {
+            coalesce->Stats.Max_Latency_Cycles = latency;
+        }
+        coalesce->Handler(events, count, coalesce->Context);
+    }
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_CoalesceCreate
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): IRQ_Num - Spare IRQ line with no peripheral behind it
+ *                 Priority - Priority the batch handler runs at
+ *                 Handler - Function called once per batch
+ *                 Context - Argument passed to Handler
+ *                 Buffer - Storage for the undelivered events
+ *                 Capacity - Number of events in Buffer, a power of two
+ * Parameters (inout): None
+ * Parameters (out): Coalesce - Coalescer to initialize
+ * Return value: boolean - FALSE if Capacity is not a power of two
+ * Description: The peripheral ISR stays short: it reads the sample or byte,
+ *              posts it and returns. The handler runs on the spare IRQ once
+ *              per batch. Starts with a threshold of 1 and no timeout,
+ *              i.e. no coalescing. NVIC_RelocateVectorTable must have been
+ *              called first.
+ *****************************************************************************/
+boolean NVIC_CoalesceCreate(NVIC_CoalesceType *Coalesce, NVIC_IRQType IRQ_Num, NVIC_IRQPriorityType Priority,
+                            NVIC_CoalesceHandlerType Handler, void *Context,
+                            NVIC_EventType *Buffer, uint32 Capacity)
+{
+    NVIC_CriticalStateType state;
+    uint8 *bytes = (uint8 *)&Coalesce->Stats;
+    uint32 i;
+
+    if (NVIC_SPSCQueueInit(&Coalesce->Queue, Buffer, Capacity) == FALSE) {
+        return FALSE;
+    }
+    Coalesce->IRQ_Num = IRQ_Num;
+    Coalesce->Handler = Handler;
+    Coalesce->Context = Context;
+    Coalesce->Max_Events = 1;
+    Coalesce->Timeout_Ticks = 0;
+    Coalesce->First_Tick = 0;
+    Coalesce->First_Cycles = 0;
+    Coalesce->Timeout_Pended = FALSE;
+    for (i = 0; i < sizeof(Coalesce->Stats); i++) {
+        bytes[i] = 0;
+    }
+
+    /* Batch latency is measured with the DWT cycle counter */
+    NVIC_DEMCR_REG |= NVIC_DEMCR_TRCENA_MASK;
+    NVIC_DWT_CTRL_REG |= NVIC_DWT_CTRL_CYCCNTENA_MASK;
+
+    state = NVIC_EnterCritical();
+    Coalesce->Next = NVIC_CoalesceList;
+    NVIC_CoalesceList = Coalesce;
+    NVIC_ExitCritical(state);
+
+    NVIC_CoalesceByIRQ[IRQ_Num] = Coalesce;
+    NVIC_DisableIRQ(IRQ_Num);
+    NVIC_ClearPending(IRQ_Num);
+    NVIC_SetPriorityIRQ(IRQ_Num, Priority);
+    NVIC_RegisterHandler(IRQ_Num, NVIC_CoalesceDispatch);
+    NVIC_EnableIRQ(IRQ_Num);
+    return TRUE;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_CoalesceSetThresholds
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Max_Events - Events that release a batch, 1 ..
+ *                               NVIC_COALESCE_MAX_BATCH
+ *                 Timeout_Ticks - SysTick periods the oldest event may wait,
+ *                                 0 to wait for the threshold only
+ * Parameters (inout): Coalesce - Coalescer to tune
+ * Parameters (out): None
+ * Return value: None
+ * Description: Trades handler runs for latency at run time, e.g. a larger
+ *              threshold at high data rates.
+ *****************************************************************************/
+void NVIC_CoalesceSetThresholds(NVIC_CoalesceType *Coalesce, uint16 Max_Events, uint16 Timeout_Ticks)
+{
+    if (Max_Events == 0) {
+        Max_Events = 1;
+    } else if (Max_Events > NVIC_COALESCE_MAX_BATCH) {
+        Max_Events = NVIC_COALESCE_MAX_BATCH;
+    } else {
+        /* In range */
+    }
+    Coalesce->Max_Events = Max_Events;
+    Coalesce->Timeout_Ticks = Timeout_Ticks;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_CoalescePost
+ * Sync/Async: Asynchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): Event - Sample, byte or event code
+ * Parameters (inout): Coalesce - Destination coalescer
+ * Parameters (out): None
+ * Return value: boolean - FALSE if the queue is full, the event is dropped
+ * Description: Single producer: call it from one peripheral ISR only. The
+ *              first event of a batch is stamped for the timeout and the
+ *              latency statistics, the threshold event pends the batch IRQ.
+ *****************************************************************************/
+boolean NVIC_CoalescePost(NVIC_CoalesceType *Coalesce, NVIC_EventType Event)
+{
+    uint32 queued = Coalesce->Queue.Head - Coalesce->Queue.Tail;
+    uint32 was_queued = queued;
+
+    if (queued == 0) {
+        NVIC_CoalesceStamp(Coalesce);
+    }
+    if (NVIC_SPSCQueuePush(&Coalesce->Queue, Event) == FALSE) {
+        Coalesce->Stats.Dropped++;
+        NVIC_TriggerIRQ(Coalesce->IRQ_Num);
+        return FALSE;
+    }
+    Coalesce->Stats.Events++;
+    /* Judge the batch on the queue after the push: if the consumer drained the events seen above
+     * in between, this event landed alone in an empty queue and needs a stamp of its own */
+    queued = Coalesce->Queue.Head - Coalesce->Queue.Tail;
+    if ((was_queued != 0) && (queued == 1)) {
+        NVIC_CoalesceStamp(Coalesce);
+    }
+    if (queued == Coalesce->Max_Events) {
+        Coalesce->Stats.Threshold_Flushes++;
+        NVIC_TriggerIRQ(Coalesce->IRQ_Num);
+    } else if (queued > Coalesce->Max_Events) {
+        /* The batch IRQ is already pending or blocked by a higher priority */
+        NVIC_TriggerIRQ(Coalesce->IRQ_Num);
+    } else {
+        /* Keep coalescing */
+    }
+    return TRUE;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_CoalesceFlush
+ * Sync/Async: Asynchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): Coalesce - Coalescer to flush
+ * Parameters (out): None
+ * Return value: None
+ * Description: Pends the batch IRQ so every queued event is delivered.
+ *****************************************************************************/
+void NVIC_CoalesceFlush(NVIC_CoalesceType *Coalesce)
+{
+    NVIC_TriggerIRQ(Coalesce->IRQ_Num);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_CoalesceTick
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Pends the batch IRQ of every coalescer holding events whose
+ *              oldest one has waited Timeout_Ticks periods or more, once per
+ *              batch. "Or more" covers ticks skipped by the tickless idle.
+ *****************************************************************************/
+void NVIC_CoalesceTick(void)
+{
+    NVIC_CoalesceType *coalesce;
+    uint32 now = ++NVIC_CoalesceTicks;
+
+    for (coalesce = NVIC_CoalesceList; coalesce != NULL_PTR; coalesce = coalesce->Next) {
+        if ((coalesce->Timeout_Ticks != 0) &&
+            (coalesce->Timeout_Pended == FALSE) &&
+            (coalesce->Queue.Head != coalesce->Queue.Tail) &&
+            ((now - coalesce->First_Tick) >= coalesce->Timeout_Ticks)) {
+            coalesce->Timeout_Pended = TRUE;
+            coalesce->Stats.Timeout_Flushes++;
+            NVIC_TriggerIRQ(coalesce->IRQ_Num);
+        }
+    }
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_CoalesceTicksToNext
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Ticks until the next tick that releases a batch on
+ *               timeout, 0xFFFFFFFF if no batch is waiting for one
+ * Description: Folded into SysTick_IdleTicks so the tickless idle wakes up
+ *              in time for the oldest batch.
+ *****************************************************************************/
+uint32 NVIC_CoalesceTicksToNext(void)
+{
+    NVIC_CoalesceType *coalesce;
+    uint32 best = 0xFFFFFFFF;
+    uint32 age;
+    NVIC_CriticalStateType state = NVIC_EnterCritical();
+
+    for (coalesce = NVIC_CoalesceList; coalesce != NULL_PTR; coalesce = coalesce->Next) {
+        if ((coalesce->Timeout_Ticks != 0) &&
+            (coalesce->Timeout_Pended == FALSE) &&
+            (coalesce->Queue.Head != coalesce->Queue.Tail)) {
+            age = NVIC_CoalesceTicks - coalesce->First_Tick;
+            if (age >= (uint32)coalesce->Timeout_Ticks - 1) {
+                best = 1;
+            } else if ((coalesce->Timeout_Ticks - age) < best) {
+                best = coalesce->Timeout_Ticks - age;
+            } else {
+                /* A sooner timeout is already known */
+            }
+        }
+    }
+
+    NVIC_ExitCritical(state);
+    return best;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_CoalesceSkip
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): Ticks - Ticks slept through by the tickless idle
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Keeps the batch ages right across ticks that produced no
+ *              interrupt. A timeout that fell inside them is released by
+ *              the next NVIC_CoalesceTick.
+ *****************************************************************************/
+void NVIC_CoalesceSkip(uint32 Ticks)
+{
+    NVIC_CoalesceTicks += Ticks;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_CoalesceGetStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Coalesce - Coalescer to read
+ * Parameters (inout): None
+ * Parameters (out): Stats - Copy of the statistics with Ratio_x100 filled in
+ * Return value: None
+ * Description: Copies the counters with exceptions masked. The latency is
+ *              counted from the oldest event of each batch, an upper bound
+ *              for the other events of the batch.
+ *****************************************************************************/
+void NVIC_CoalesceGetStats(NVIC_CoalesceType *Coalesce, NVIC_CoalesceStatsType *Stats)
+{
+    NVIC_CriticalStateType state = NVIC_EnterCritical();
+    *Stats = Coalesce->Stats;
+    NVIC_ExitCritical(state);
+
+    Stats->Ratio_x100 = (Stats->Batches != 0) ? (uint32)(((uint64)Stats->Events * 100) / Stats->Batches) : 0;
+}
@@ -0,0 +1,99 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: nvic_coalesce.h
+ *
+ * Description: Header file for the interrupt coalescing and batched handler dispatch
+ *
+ * Author: Ahmed Osama
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_COALESCE_H_
+#define NVIC_COALESCE_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "nvic.h"
+#include "nvic_queue.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Largest batch handed to a handler, also the upper bound of the event threshold.
+ * The batch is copied to the dispatcher stack, 4 bytes per event. */
+#ifndef NVIC_COALESCE_MAX_BATCH
+#define NVIC_COALESCE_MAX_BATCH              32
+#endif
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef void (*NVIC_CoalesceHandlerType)(const NVIC_EventType *Events, uint32 Count, void *Context);
+
+typedef struct
+{
+    uint32 Events;                      /* Events posted */
+    uint32 Dropped;                     /* Events lost to a full queue */
+    uint32 Batches;                     /* Handler runs */
+    uint32 Threshold_Flushes;           /* Batches released by the event threshold */
+    uint32 Timeout_Flushes;             /* Batches released by the timeout */
+    uint32 Ratio_x100;                  /* Events per batch x 100, filled in by NVIC_CoalesceGetStats */
+    uint32 Max_Latency_Cycles;          /* Oldest event of a batch to handler start */
+    uint64 Total_Latency_Cycles;
+} NVIC_CoalesceStatsType;
+
+/* Caller-owned coalescer, one spare IRQ line runs its handler at the IRQ priority */
+typedef struct NVIC_Coalesce
+{
+    struct NVIC_Coalesce *Next;         /* List walked by NVIC_CoalesceTick */
+    NVIC_IRQType IRQ_Num;
+    NVIC_CoalesceHandlerType Handler;
+    void *Context;
+    NVIC_SPSCQueueType Queue;           /* Peripheral ISR -> batch handler */
+    volatile uint16 Max_Events;         /* Event threshold */
+    volatile uint16 Timeout_Ticks;      /* Age of the oldest event that forces a batch, 0 for none */
+    volatile uint32 First_Tick;         /* Tick and cycle stamps of the oldest undelivered event */
+    volatile uint32 First_Cycles;
+    volatile boolean Timeout_Pended;    /* The timeout already released the batch stamped First_Tick */
+    NVIC_CoalesceStatsType Stats;
+} NVIC_CoalesceType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+// Binds a coalescer to a spare IRQ line, sets its priority and enables it, returns FALSE if Capacity is not a power of two
+boolean NVIC_CoalesceCreate(NVIC_CoalesceType *Coalesce, NVIC_IRQType IRQ_Num, NVIC_IRQPriorityType Priority,
+                            NVIC_CoalesceHandlerType Handler, void *Context,
+                            NVIC_EventType *Buffer, uint32 Capacity);
+
+// Sets the event threshold and the timeout, callable at any time
+void NVIC_CoalesceSetThresholds(NVIC_CoalesceType *Coalesce, uint16 Max_Events, uint16 Timeout_Ticks);
+
+// Queues one event from the peripheral ISR and releases a batch once the threshold is reached, returns FALSE if the queue is full
+boolean NVIC_CoalescePost(NVIC_CoalesceType *Coalesce, NVIC_EventType Event);
+
+// Releases the queued events now
+void NVIC_CoalesceFlush(NVIC_CoalesceType *Coalesce);
+
+// Releases the batches whose oldest event timed out, called from SysTick_Handler
+void NVIC_CoalesceTick(void);
+
+// Returns the number of ticks until the next tick that releases a batch on timeout
+uint32 NVIC_CoalesceTicksToNext(void);
+
+// Moves the coalescer tick count forward by Ticks that produced no interrupt
+void NVIC_CoalesceSkip(uint32 Ticks);
+
+// Copies the statistics of a coalescer
+void NVIC_CoalesceGetStats(NVIC_CoalesceType *Coalesce, NVIC_CoalesceStatsType *Stats);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_COALESCE_H_ */
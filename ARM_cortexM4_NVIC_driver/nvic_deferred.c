@@ -0,0 +1,103 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: nvic_deferred.c
+ *
+ * Description: Source file for deferred work dispatch on a software triggered NVIC line
+ *
+ * Author: Ahmed Osama
+ *
+ ******************************************************************************/
+#include "nvic_deferred.h"
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static NVIC_IRQType NVIC_DeferredIRQ;
+static NVIC_DeferredWorkType *NVIC_DeferredTable[NVIC_DEFERRED_MAX_WORK];
+static uint8 NVIC_DeferredCount = 0;
+
+/*****************************************************************************
+ * Service Name: NVIC_DeferredInit
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): Soft_IRQ - Unused IRQ line dedicated to deferred work
+ *                 Priority - Priority of the deferred work, lower than the posting ISRs
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Configures the software IRQ line used to drain deferred work.
+ *****************************************************************************/
+void NVIC_DeferredInit(NVIC_IRQType Soft_IRQ, NVIC_IRQPriorityType Priority)
+{
+    NVIC_DeferredIRQ = Soft_IRQ;
+    NVIC_DeferredCount = 0;
+    NVIC_SetPriorityIRQ(Soft_IRQ, Priority);
+    NVIC_ClearPending(Soft_IRQ);
+    NVIC_EnableIRQ(Soft_IRQ);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_DeferredRegister
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): Work_Item - Work item with Work and Context filled in
+ * Parameters (out): None
+ * Return value: boolean - FALSE if NVIC_DEFERRED_MAX_WORK items are registered
+ * Description: Adds a work item to the dispatch table. Call it from thread
+ *              context before the item is first posted.
+ *****************************************************************************/
+boolean NVIC_DeferredRegister(NVIC_DeferredWorkType *Work_Item)
+{
+    if (NVIC_DeferredCount >= NVIC_DEFERRED_MAX_WORK) {
+        return FALSE;
+    }
+    Work_Item->Pending = FALSE;
+    NVIC_DeferredTable[NVIC_DeferredCount] = Work_Item;
+    NVIC_DeferredCount++;
+    return TRUE;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_DeferredPost
+ * Sync/Async: Asynchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): Work_Item - Registered work item to run
+ * Parameters (out): None
+ * Return value: None
+ * Description: Sets the item Pending flag (a byte store) and pends the
+ *              deferred IRQ through STIR (a word store), with no RMW and no
+ *              critical section. Posting an item that is still pending runs
+ *              it only once.
+ *****************************************************************************/
+void NVIC_DeferredPost(NVIC_DeferredWorkType *Work_Item)
+{
+    Work_Item->Pending = TRUE;
+    NVIC_TriggerIRQ(NVIC_DeferredIRQ);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_DeferredDispatch
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Runs every pending work item. The flag is cleared before the
+ *              work runs, so an item posted again meanwhile is not lost.
+ *****************************************************************************/
+void NVIC_DeferredDispatch(void)
+{
+    uint8 i;
+    for (i = 0; i < NVIC_DeferredCount; i++) {
+        NVIC_DeferredWorkType *item = NVIC_DeferredTable[i];
+        if (item->Pending != FALSE) {
+            item->Pending = FALSE;
+            item->Work(item->Context);
+        }
+    }
+}
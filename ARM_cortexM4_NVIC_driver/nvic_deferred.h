@@ -0,0 +1,62 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: nvic_deferred.h
+ *
+ * Description: Header file for deferred work dispatch on a software triggered NVIC line
+ *
+ * Author: Ahmed Osama
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_DEFERRED_H_
+#define NVIC_DEFERRED_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "nvic.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Maximum number of work items that can be registered */
+#ifndef NVIC_DEFERRED_MAX_WORK
+#define NVIC_DEFERRED_MAX_WORK               16
+#endif
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef void (*NVIC_DeferredWorkFuncType)(void *Context);
+
+/* Caller-owned work item, Pending is written by posters and cleared by the dispatcher */
+typedef struct
+{
+    NVIC_DeferredWorkFuncType Work;
+    void *Context;
+    volatile uint8 Pending;
+} NVIC_DeferredWorkType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+// Selects the unused IRQ line that runs deferred work, sets its priority and enables it
+void NVIC_DeferredInit(NVIC_IRQType Soft_IRQ, NVIC_IRQPriorityType Priority);
+
+// Registers a work item, returns FALSE if the table is full
+boolean NVIC_DeferredRegister(NVIC_DeferredWorkType *Work_Item);
+
+// Marks a work item pending and triggers the deferred IRQ, callable from any ISR
+void NVIC_DeferredPost(NVIC_DeferredWorkType *Work_Item);
+
+// Runs every pending work item, must be called from the handler of the deferred IRQ line
+void NVIC_DeferredDispatch(void);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_DEFERRED_H_ */
@@ -0,0 +1,135 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: nvic_device.h
+ *
+ * Description: Device descriptor of the Cortex-M4 part the NVIC driver is built for
+ *
+ * Author: Ahmed Osama
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_DEVICE_H_
+#define NVIC_DEVICE_H_
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/*
+ * Every register count, mask and shift of the driver is derived from the three
+ * values below, so they fold to constants for the selected part.
+ * Another part is selected by pointing NVIC_DEVICE_HEADER at a header (hand written
+ * or generated) that provides the same three definitions and NVIC_IRQType, e.g.
+ *   -DNVIC_DEVICE_HEADER=\"my_part_nvic.h\"
+ *
+ *   NVIC_DEVICE_IRQ_LINES   IRQ lines implemented by the part, at most 240
+ *   NVIC_PRIORITY_BITS      Priority bits implemented by the part, 3 .. 4 (the priority
+ *                           enumerations of nvic.h stop at Priority_15)
+ *   NVIC_DEVICE_LAST_IRQ    Last enumerator of NVIC_IRQType
+ */
+#if defined(NVIC_DEVICE_HEADER)
+
+#include NVIC_DEVICE_HEADER
+
+#else
+
+/* TM4C123GH6PM */
+#define NVIC_DEVICE_IRQ_LINES                139
+#ifndef NVIC_PRIORITY_BITS
+#define NVIC_PRIORITY_BITS                   3
+#endif
+#define NVIC_DEVICE_LAST_IRQ                 PWM_1_FAULT
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef enum {
+    GPIO_PORT_A=0,                    // GPIO Port A
+    GPIO_PORT_B,                        // GPIO Port B
+    GPIO_PORT_C,                        // GPIO Port C
+    GPIO_PORT_D,                        // GPIO Port D
+    GPIO_PORT_E,                        // GPIO Port E
+    UART0_RXTX,                         // UART0 Rx and Tx
+    UART1_RXTX,                         // UART1 Rx and Tx
+    SSI0_RXTX,                          // SSI0 Rx and Tx
+    I2C0_MASTER_SLAVE,                  // I2C0 Master and Slave
+    PWM_FAULT,                          // PWM Fault
+    PWM_GENERATOR_0,                    // PWM Generator 0
+    PWM_GENERATOR_1,                    // PWM Generator 1
+    PWM_GENERATOR_2,                    // PWM Generator 2
+    QUADRATURE_ENCODER_0,               // Quadrature Encoder 0
+    ADC_SEQUENCE_0,                     // ADC Sequence 0
+    ADC_SEQUENCE_1,                     // ADC Sequence 1
+    ADC_SEQUENCE_2,                     // ADC Sequence 2
+    ADC_SEQUENCE_3,                     // ADC Sequence 3
+    WATCHDOG_TIMER,                     // Watchdog timer
+    TIMER_0_SUBTIMER_A,                 // Timer 0 subtimer A
+    TIMER_0_SUBTIMER_B,                 // Timer 0 subtimer B
+    TIMER_1_SUBTIMER_A,                 // Timer 1 subtimer A
+    TIMER_1_SUBTIMER_B,                 // Timer 1 subtimer B
+    TIMER_2_SUBTIMER_A,                 // Timer 2 subtimer A
+    TIMER_2_SUBTIMER_B,                 // Timer 2 subtimer B
+    ANALOG_COMPARATOR_0,                // Analog Comparator 0
+    ANALOG_COMPARATOR_1,                // Analog Comparator 1
+    ANALOG_COMPARATOR_2,                // Analog Comparator 2
+    SYSTEM_CONTROL,                     // System Control (PLL, OSC, BO)
+    FLASH_CONTROL,                      // FLASH Control
+    GPIO_PORT_F,                        // GPIO Port F
+    GPIO_PORT_G,                        // GPIO Port G
+    GPIO_PORT_H,                        // GPIO Port H
+    UART2_RXTX,                         // UART2 Rx and Tx
+    SSI1_RXTX,                          // SSI1 Rx and Tx
+    TIMER_3_SUBTIMER_A,                 // Timer 3 subtimer A
+    TIMER_3_SUBTIMER_B,                 // Timer 3 subtimer B
+    I2C1_MASTER_SLAVE,                  // I2C1 Master and Slave
+    QUADRATURE_ENCODER_1,               // Quadrature Encoder 1
+    CAN0,                               // CAN0
+    CAN1,                               // CAN1
+    HIBERNATE,                          // Hibernate
+    USB0,                               // USB0
+    PWM_GENERATOR_3,                    // PWM Generator 3
+    UDMA_SOFTWARE_TRANSFER,             // uDMA Software Transfer
+    UDMA_ERROR,                         // uDMA Error
+    ADC1_SEQUENCE_0,                    // ADC1 Sequence 0
+    ADC1_SEQUENCE_1,                    // ADC1 Sequence 1
+    ADC1_SEQUENCE_2,                    // ADC1 Sequence 2
+    ADC1_SEQUENCE_3,                    // ADC1 Sequence 3
+    GPIO_PORT_J,                        // GPIO Port J
+    GPIO_PORT_K,                        // GPIO Port K
+    GPIO_PORT_L,                        // GPIO Port L
+    SSI2_RXTX,                          // SSI2 Rx and Tx
+    SSI3_RXTX,                          // SSI3 Rx and Tx
+    UART3_RXTX,                         // UART3 Rx and Tx
+    UART4_RXTX,                         // UART4 Rx and Tx
+    UART5_RXTX,                         // UART5 Rx and Tx
+    UART6_RXTX,                         // UART6 Rx and Tx
+    UART7_RXTX,                         // UART7 Rx and Tx
+    I2C2_MASTER_SLAVE,                  // I2C2 Master and Slave
+    I2C3_MASTER_SLAVE,                  // I2C3 Master and Slave
+    TIMER_4_SUBTIMER_A,                 // Timer 4 subtimer A
+    TIMER_4_SUBTIMER_B,                 // Timer 4 subtimer B
+    I2C4_MASTER_SLAVE,                  // I2C4 Master and Slave
+    I2C5_MASTER_SLAVE,                  // I2C5 Master and Slave
+    GPIO_PORT_M,                        // GPIO Port M
+    GPIO_PORT_N,                        // GPIO Port N
+    QUADRATURE_ENCODER_2,               // Quadrature Encoder 2
+    GPIO_PORT_P,                        // GPIO Port P (Summary or P0)
+    GPIO_PORT_Q,                        // GPIO Port Q (Summary or Q0)
+    GPIO_PORT_R,                        // GPIO Port R
+    GPIO_PORT_S,                        // GPIO Port S
+    PWM_1_GENERATOR_0,                  // PWM 1 Generator 0
+    PWM_1_GENERATOR_1,                  // PWM 1 Generator 1
+    PWM_1_GENERATOR_2,                  // PWM 1 Generator 2
+    PWM_1_GENERATOR_3,                  // PWM 1 Generator 3
+    PWM_1_FAULT                         // PWM 1 Fault
+} NVIC_IRQType;
+
+#endif
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_DEVICE_H_ */
@@ -0,0 +1,214 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: nvic_profiler.c
+ *
+ * Description: Source file for the DWT cycle counter interrupt profiler
+ *
+ * Author: Ahmed Osama
+ *
+ ******************************************************************************/
+#include "nvic_profiler.h"
+
+#if NVIC_PROFILER_ENABLED
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static NVIC_ProfilerStatsType NVIC_ProfilerStats[NVIC_PROFILER_SLOTS];
+static NVIC_HandlerType NVIC_ProfilerHandlers[NVIC_IRQ_COUNT];
+static volatile uint32 NVIC_ProfilerRequest[NVIC_IRQ_COUNT];
+static volatile uint8 NVIC_ProfilerRequested[NVIC_IRQ_COUNT];
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+/* Common vector for profiled IRQs, finds the IRQ from IPSR and times its handler */
+static void NVIC_ProfilerDispatch(void)
+{
+    uint32 start = NVIC_DWT_CYCCNT_REG;
+    uint32 latency = NVIC_PROFILER_NO_LATENCY;
+    uint32 irq;
+
+    NVIC_READ_IPSR(irq);
+    irq -= NVIC_IRQ_VECTOR_OFFSET;
+    if (NVIC_ProfilerRequested[irq] != FALSE) {
+        NVIC_ProfilerRequested[irq] = FALSE;
+        latency = start - NVIC_ProfilerRequest[irq];
+    }
+    NVIC_ProfilerHandlers[irq]();
+    NVIC_ProfilerRecord(irq, start, latency);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_ProfilerInit
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Enables trace, starts DWT CYCCNT and clears the stats.
+ *****************************************************************************/
+void NVIC_ProfilerInit(void)
+{
+    NVIC_DEMCR_REG |= NVIC_DEMCR_TRCENA_MASK;
+    NVIC_DWT_CYCCNT_REG = 0;
+    NVIC_DWT_CTRL_REG |= NVIC_DWT_CTRL_CYCCNTENA_MASK;
+    NVIC_ProfilerReset();
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_ProfilerReset
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Clears every stats slot.
+ *****************************************************************************/
+void NVIC_ProfilerReset(void)
+{
+    uint32 i;
+    uint8 bucket;
+    NVIC_CriticalStateType state = NVIC_EnterCritical();
+
+    for (i = 0; i < NVIC_PROFILER_SLOTS; i++) {
+        NVIC_ProfilerStats[i].Count = 0;
+        NVIC_ProfilerStats[i].Min_Cycles = 0xFFFFFFFF;
+        NVIC_ProfilerStats[i].Max_Cycles = 0;
+        NVIC_ProfilerStats[i].Mean_Cycles = 0;
+        NVIC_ProfilerStats[i].Total_Cycles = 0;
+        NVIC_ProfilerStats[i].Latency_Count = 0;
+        NVIC_ProfilerStats[i].Max_Latency_Cycles = 0;
+        NVIC_ProfilerStats[i].Total_Latency_Cycles = 0;
+        for (bucket = 0; bucket < NVIC_PROFILER_BUCKETS; bucket++) {
+            NVIC_ProfilerStats[i].Histogram[bucket] = 0;
+        }
+    }
+
+    NVIC_ExitCritical(state);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_ProfilerRegisterHandler
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): IRQ_Num - Interrupt request number
+ *                 Handler - IRQ handler to profile
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Points the IRQ vector at the profiler dispatcher, which calls
+ *              Handler. NVIC_RelocateVectorTable must have been called first.
+ *****************************************************************************/
+void NVIC_ProfilerRegisterHandler(NVIC_IRQType IRQ_Num, NVIC_HandlerType Handler)
+{
+    NVIC_ProfilerHandlers[IRQ_Num] = Handler;
+    NVIC_RegisterHandler(IRQ_Num, NVIC_ProfilerDispatch);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_ProfilerTrigger
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Interrupt request number
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Stamps the request time and pends the IRQ through STIR, so the
+ *              dispatcher can record the entry latency.
+ *****************************************************************************/
+void NVIC_ProfilerTrigger(NVIC_IRQType IRQ_Num)
+{
+    NVIC_ProfilerRequest[IRQ_Num] = NVIC_DWT_CYCCNT_REG;
+    NVIC_ProfilerRequested[IRQ_Num] = TRUE;
+    NVIC_TriggerIRQ(IRQ_Num);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_ProfilerRecord
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): Index - Stats slot (IRQ number or NVIC_PROFILER_SYSTICK_INDEX)
+ *                 Start_Cycles - CYCCNT at handler entry
+ *                 Latency_Cycles - Entry latency or NVIC_PROFILER_NO_LATENCY
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Adds one handler run to a stats slot. A slot is only written
+ *              by its own handler, which cannot preempt itself, so no lock is
+ *              needed. The sequence is odd during the update for readers.
+ *****************************************************************************/
+void NVIC_ProfilerRecord(uint32 Index, uint32 Start_Cycles, uint32 Latency_Cycles)
+{
+    NVIC_ProfilerStatsType *stats = &NVIC_ProfilerStats[Index];
+    uint32 cycles = NVIC_DWT_CYCCNT_REG - Start_Cycles;
+    uint32 bucket = (cycles == 0) ? 0 : (31 - (uint32)__builtin_clz(cycles));
+
+    if (bucket >= NVIC_PROFILER_BUCKETS) {
+        bucket = NVIC_PROFILER_BUCKETS - 1;
+    }
+
+    stats->Sequence++;
+    __asm volatile ("" ::: "memory");
+    stats->Count++;
+    stats->Total_Cycles += cycles;
+    if (cycles < stats->Min_Cycles) {
+        stats->Min_Cycles = cycles;
+    }
+    if (cycles > stats->Max_Cycles) {
+        stats->Max_Cycles = cycles;
+    }
+    if (Latency_Cycles != NVIC_PROFILER_NO_LATENCY) {
+        stats->Latency_Count++;
+        stats->Total_Latency_Cycles += Latency_Cycles;
+        if (Latency_Cycles > stats->Max_Latency_Cycles) {
+            stats->Max_Latency_Cycles = Latency_Cycles;
+        }
+    }
+    stats->Histogram[bucket]++;
+    __asm volatile ("" ::: "memory");
+    stats->Sequence++;
+}
+
+#endif
+
+/*****************************************************************************
+ * Service Name: NVIC_ProfilerSnapshot
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Index - Stats slot (IRQ number or NVIC_PROFILER_SYSTICK_INDEX)
+ * Parameters (inout): None
+ * Parameters (out): Stats - Consistent copy of the slot, Mean_Cycles filled in
+ * Return value: boolean - FALSE if the profiler is compiled out or the slot is
+ *                         being updated by a handler this caller preempted
+ * Description: Copies a stats slot without masking interrupts. The copy is
+ *              retried if the handler updated the slot meanwhile.
+ *****************************************************************************/
+boolean NVIC_ProfilerSnapshot(uint32 Index, NVIC_ProfilerStatsType *Stats)
+{
+#if NVIC_PROFILER_ENABLED
+    uint32 seq;
+
+    do {
+        seq = NVIC_ProfilerStats[Index].Sequence;
+        if (seq & 1) {
+            return FALSE;
+        }
+        __asm volatile ("" ::: "memory");
+        *Stats = NVIC_ProfilerStats[Index];
+        __asm volatile ("" ::: "memory");
+    } while (seq != NVIC_ProfilerStats[Index].Sequence);
+
+    Stats->Mean_Cycles = (Stats->Count != 0) ? (uint32)(Stats->Total_Cycles / Stats->Count) : 0;
+    return TRUE;
+#else
+    (void)Index;
+    (void)Stats;
+    return FALSE;
+#endif
+}
@@ -0,0 +1,119 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: nvic_profiler.h
+ *
+ * Description: Header file for the DWT cycle counter interrupt profiler
+ *
+ * Author: Ahmed Osama
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_PROFILER_H_
+#define NVIC_PROFILER_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "nvic.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Set to 1 to build the profiler, with 0 every hook below compiles to nothing */
+#ifndef NVIC_PROFILER_ENABLED
+#define NVIC_PROFILER_ENABLED                0
+#endif
+
+/* Number of log2 histogram buckets, bucket n counts durations in [2^n, 2^(n+1)) cycles, the last one is open ended */
+#ifndef NVIC_PROFILER_BUCKETS
+#define NVIC_PROFILER_BUCKETS                16
+#endif
+
+/* Stats slots: one per IRQ line plus one for SysTick_Handler */
+#define NVIC_PROFILER_SYSTICK_INDEX          NVIC_IRQ_COUNT
+#define NVIC_PROFILER_SLOTS                  (NVIC_IRQ_COUNT + 1)
+
+/* Latency value meaning "not measured for this call" */
+#define NVIC_PROFILER_NO_LATENCY             0xFFFFFFFF
+
+/* Debug Exception and Monitor Control and Data Watchpoint and Trace registers */
+#ifndef NVIC_DEMCR_REG
+#define NVIC_DEMCR_REG                       (*((volatile uint32 *)0xE000EDFC))
+#endif
+#ifndef NVIC_DWT_CTRL_REG
+#define NVIC_DWT_CTRL_REG                    (*((volatile uint32 *)0xE0001000))
+#endif
+#ifndef NVIC_DWT_CYCCNT_REG
+#define NVIC_DWT_CYCCNT_REG                  (*((volatile uint32 *)0xE0001004))
+#endif
+#define NVIC_DEMCR_TRCENA_MASK               0x01000000
+#define NVIC_DWT_CTRL_CYCCNTENA_MASK         0x00000001
+
+#if NVIC_PROFILER_ENABLED
+
+/* Hooks for handlers that are not dispatched through the profiler, e.g. SysTick_Handler */
+#define NVIC_PROFILER_HANDLER_ENTER()                 uint32 nvic_profiler_start = NVIC_DWT_CYCCNT_REG
+#define NVIC_PROFILER_HANDLER_EXIT(INDEX, LATENCY)    NVIC_ProfilerRecord((INDEX), nvic_profiler_start, (LATENCY))
+
+#else
+
+#define NVIC_PROFILER_HANDLER_ENTER()
+#define NVIC_PROFILER_HANDLER_EXIT(INDEX, LATENCY)
+
+#define NVIC_ProfilerInit()                           ((void)0)
+#define NVIC_ProfilerReset()                          ((void)0)
+#define NVIC_ProfilerRegisterHandler(IRQ, HANDLER)    NVIC_RegisterHandler((IRQ), (HANDLER))
+#define NVIC_ProfilerTrigger(IRQ)                     NVIC_TriggerIRQ(IRQ)
+
+#endif
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    volatile uint32 Sequence;           /* Odd while the slot is being updated */
+    uint32 Count;
+    uint32 Min_Cycles;
+    uint32 Max_Cycles;
+    uint32 Mean_Cycles;                 /* Filled in by NVIC_ProfilerSnapshot */
+    uint64 Total_Cycles;
+    uint32 Latency_Count;               /* Calls whose entry latency was measured */
+    uint32 Max_Latency_Cycles;
+    uint64 Total_Latency_Cycles;
+    uint32 Histogram[NVIC_PROFILER_BUCKETS];
+} NVIC_ProfilerStatsType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+#if NVIC_PROFILER_ENABLED
+
+// Starts the DWT cycle counter and clears every stats slot
+void NVIC_ProfilerInit(void);
+
+// Clears every stats slot
+void NVIC_ProfilerReset(void);
+
+// Installs a profiled IRQ handler, the hardware enters the profiler which times the call to Handler
+void NVIC_ProfilerRegisterHandler(NVIC_IRQType IRQ_Num, NVIC_HandlerType Handler);
+
+// Pends an IRQ through STIR and stamps the request so its entry latency is measured
+void NVIC_ProfilerTrigger(NVIC_IRQType IRQ_Num);
+
+// Adds one handler run to a stats slot, used by NVIC_PROFILER_HANDLER_EXIT
+void NVIC_ProfilerRecord(uint32 Index, uint32 Start_Cycles, uint32 Latency_Cycles);
+
+#endif
+
+// Copies a stats slot while the system runs, returns FALSE if the slot is being updated by a preempted handler
+boolean NVIC_ProfilerSnapshot(uint32 Index, NVIC_ProfilerStatsType *Stats);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_PROFILER_H_ */
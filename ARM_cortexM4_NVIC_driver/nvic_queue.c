@@ -0,0 +1,234 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: nvic_queue.c
+ *
+ * Description: Source file for the lock-free ISR to thread event queues
+ *
+ * Author: Ahmed Osama
+ *
+ ******************************************************************************/
+#include "nvic_queue.h"
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+/* LDREX, any exception entry or return in between makes the matching STREX fail */
+static inline uint32 NVIC_LoadExclusive(volatile uint32 *Address)
+{
+    uint32 value;
+    NVIC_LOAD_EXCLUSIVE(value, Address);
+    return value;
+}
+
+/* STREX, returns 0 on success */
+static inline uint32 NVIC_StoreExclusive(volatile uint32 *Address, uint32 Value)
+{
+    uint32 failed;
+    NVIC_STORE_EXCLUSIVE(failed, Address, Value);
+    return failed;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_SPSCQueueInit
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): Buffer - Storage for Capacity events
+ *                 Capacity - Number of events, a power of two
+ * Parameters (inout): None
+ * Parameters (out): Queue - Queue to initialize
+ * Return value: boolean - FALSE if Capacity is not a power of two
+ * Description: Initializes an empty single producer / single consumer queue.
+ *****************************************************************************/
+boolean NVIC_SPSCQueueInit(NVIC_SPSCQueueType *Queue, NVIC_EventType *Buffer, uint32 Capacity)
+{
+    if ((Capacity == 0) || ((Capacity & (Capacity - 1)) != 0)) {
+        return FALSE;
+    }
+    Queue->Buffer = Buffer;
+    Queue->Mask = Capacity - 1;
+    Queue->Head = 0;
+    Queue->Tail = 0;
+    return TRUE;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_SPSCQueuePush
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): Event - Event to post
+ * Parameters (inout): Queue - Queue owned by a single producer
+ * Parameters (out): None
+ * Return value: boolean - FALSE if the queue is full
+ * Description: Wait-free post, the slot is filled before Head publishes it.
+ *****************************************************************************/
+boolean NVIC_SPSCQueuePush(NVIC_SPSCQueueType *Queue, NVIC_EventType Event)
+{
+    uint32 head = Queue->Head;
+
+    if ((head - Queue->Tail) > Queue->Mask) {
+        return FALSE;
+    }
+    Queue->Buffer[head & Queue->Mask] = Event;
+    Data_Memory_Barrier();
+    Queue->Head = head + 1;
+    return TRUE;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_SPSCQueuePop
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): Queue - Queue owned by a single consumer
+ * Parameters (out): Event - Oldest event
+ * Return value: boolean - FALSE if the queue is empty
+ * Description: Wait-free take of one event.
+ *****************************************************************************/
+boolean NVIC_SPSCQueuePop(NVIC_SPSCQueueType *Queue, NVIC_EventType *Event)
+{
+    return (NVIC_SPSCQueuePopBatch(Queue, Event, 1) != 0) ? TRUE : FALSE;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_SPSCQueuePopBatch
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): Max_Events - Size of Events
+ * Parameters (inout): Queue - Queue owned by a single consumer
+ * Parameters (out): Events - Oldest events, in posting order
+ * Return value: uint32 - Number of events taken
+ * Description: Wait-free take of every available event up to Max_Events,
+ *              the slots are released with a single Tail store.
+ *****************************************************************************/
+uint32 NVIC_SPSCQueuePopBatch(NVIC_SPSCQueueType *Queue, NVIC_EventType *Events, uint32 Max_Events)
+{
+    uint32 tail = Queue->Tail;
+    uint32 count = Queue->Head - tail;
+    uint32 i;
+
+    if (count > Max_Events) {
+        count = Max_Events;
+    }
+    Data_Memory_Barrier();
+    for (i = 0; i < count; i++) {
+        Events[i] = Queue->Buffer[(tail + i) & Queue->Mask];
+    }
+    Data_Memory_Barrier();
+    Queue->Tail = tail + count;
+    return count;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_MPSCQueueInit
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): Cells - Storage for Capacity slots
+ *                 Capacity - Number of slots, a power of two
+ * Parameters (inout): None
+ * Parameters (out): Queue - Queue to initialize
+ * Return value: boolean - FALSE if Capacity is not a power of two
+ * Description: Initializes an empty multi producer / single consumer queue.
+ *****************************************************************************/
+boolean NVIC_MPSCQueueInit(NVIC_MPSCQueueType *Queue, NVIC_MPSCCellType *Cells, uint32 Capacity)
+{
+    uint32 i;
+
+    if ((Capacity == 0) || ((Capacity & (Capacity - 1)) != 0)) {
+        return FALSE;
+    }
+    for (i = 0; i < Capacity; i++) {
+        Cells[i].Sequence = i;
+    }
+    Queue->Cells = Cells;
+    Queue->Mask = Capacity - 1;
+    Queue->Head = 0;
+    Queue->Tail = 0;
+    return TRUE;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_MPSCQueuePush
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Event - Event to post
+ * Parameters (inout): Queue - Queue shared by several producers
+ * Parameters (out): None
+ * Return value: boolean - FALSE if the queue is full
+ * Description: Claims a slot by advancing Head with LDREX/STREX, fills it and
+ *              publishes it through the slot Sequence. The claim is retried
+ *              only when a higher priority producer posted in between, so no
+ *              critical section is needed at any priority level.
+ *****************************************************************************/
+boolean NVIC_MPSCQueuePush(NVIC_MPSCQueueType *Queue, NVIC_EventType Event)
+{
+    NVIC_MPSCCellType *cell;
+    uint32 head;
+    sint32 lag;
+
+    do {
+        head = NVIC_LoadExclusive(&Queue->Head);
+        cell = &Queue->Cells[head & Queue->Mask];
+        lag = (sint32)(cell->Sequence - head);
+        if (lag < 0) {
+            /* The slot still holds an event the consumer has not taken */
+            NVIC_CLEAR_EXCLUSIVE();
+            return FALSE;
+        }
+    } while ((lag != 0) || (NVIC_StoreExclusive(&Queue->Head, head + 1) != 0));
+
+    cell->Event = Event;
+    Data_Memory_Barrier();
+    cell->Sequence = head + 1;
+    return TRUE;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_MPSCQueuePop
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): Queue - Queue owned by a single consumer
+ * Parameters (out): Event - Oldest published event
+ * Return value: boolean - FALSE if no published event is available
+ * Description: Takes one event.
+ *****************************************************************************/
+boolean NVIC_MPSCQueuePop(NVIC_MPSCQueueType *Queue, NVIC_EventType *Event)
+{
+    return (NVIC_MPSCQueuePopBatch(Queue, Event, 1) != 0) ? TRUE : FALSE;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_MPSCQueuePopBatch
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): Max_Events - Size of Events
+ * Parameters (inout): Queue - Queue owned by a single consumer
+ * Parameters (out): Events - Oldest published events, in claim order
+ * Return value: uint32 - Number of events taken
+ * Description: Takes published events until Max_Events or the first slot that
+ *              is claimed but not yet filled by a preempted producer.
+ *****************************************************************************/
+uint32 NVIC_MPSCQueuePopBatch(NVIC_MPSCQueueType *Queue, NVIC_EventType *Events, uint32 Max_Events)
+{
+    NVIC_MPSCCellType *cell;
+    uint32 tail = Queue->Tail;
+    uint32 count = 0;
+
+    while (count < Max_Events) {
+        cell = &Queue->Cells[tail & Queue->Mask];
+        if (cell->Sequence != (tail + 1)) {
+            break;
+        }
+        Data_Memory_Barrier();
+        Events[count] = cell->Event;
+        Data_Memory_Barrier();
+        cell->Sequence = tail + Queue->Mask + 1;   /* Free for the producer one lap ahead */
+        tail++;
+        count++;
+    }
+    Queue->Tail = tail;
+    return count;
+}
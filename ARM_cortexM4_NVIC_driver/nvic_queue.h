@@ -0,0 +1,101 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: nvic_queue.h
+ *
+ * Description: Header file for the lock-free ISR to thread event queues
+ *
+ * Author: Ahmed Osama
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_QUEUE_H_
+#define NVIC_QUEUE_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "nvic.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Exclusive access instructions, may be defined before including nvic.h (host builds).
+ * NVIC_STORE_EXCLUSIVE sets FAILED to 0 when the store went through. */
+#ifndef NVIC_LOAD_EXCLUSIVE
+#define NVIC_LOAD_EXCLUSIVE(VALUE, ADDRESS)            __asm volatile (" LDREX %0, [%1] " : "=r" (VALUE) : "r" (ADDRESS) : "memory")
+#endif
+#ifndef NVIC_STORE_EXCLUSIVE
+#define NVIC_STORE_EXCLUSIVE(FAILED, ADDRESS, VALUE)   __asm volatile (" STREX %0, %2, [%1] " : "=&r" (FAILED) : "r" (ADDRESS), "r" (VALUE) : "memory")
+#endif
+#ifndef NVIC_CLEAR_EXCLUSIVE
+#define NVIC_CLEAR_EXCLUSIVE()                         __asm volatile (" CLREX " ::: "memory")
+#endif
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Event carried by the queues, an event code or a pointer */
+typedef uint32 NVIC_EventType;
+
+/* Single producer / single consumer ring, Head and Tail are free running indexes */
+typedef struct
+{
+    NVIC_EventType *Buffer;
+    uint32 Mask;                        /* Capacity - 1, capacity is a power of two */
+    volatile uint32 Head;               /* Written by the producer only */
+    volatile uint32 Tail;               /* Written by the consumer only */
+} NVIC_SPSCQueueType;
+
+/* Slot of a multi-producer queue, Sequence tells whether the slot is free or holds a published event */
+typedef struct
+{
+    volatile uint32 Sequence;
+    NVIC_EventType Event;
+} NVIC_MPSCCellType;
+
+/* Multi producer / single consumer ring, producers claim slots with LDREX/STREX */
+typedef struct
+{
+    NVIC_MPSCCellType *Cells;
+    uint32 Mask;
+    volatile uint32 Head;               /* Next slot to claim, shared by the producers */
+    volatile uint32 Tail;               /* Written by the consumer only */
+} NVIC_MPSCQueueType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+// Attaches a buffer to an SPSC queue, returns FALSE if Capacity is not a power of two
+boolean NVIC_SPSCQueueInit(NVIC_SPSCQueueType *Queue, NVIC_EventType *Buffer, uint32 Capacity);
+
+// Posts one event, returns FALSE if the queue is full
+boolean NVIC_SPSCQueuePush(NVIC_SPSCQueueType *Queue, NVIC_EventType Event);
+
+// Takes one event, returns FALSE if the queue is empty
+boolean NVIC_SPSCQueuePop(NVIC_SPSCQueueType *Queue, NVIC_EventType *Event);
+
+// Takes up to Max_Events events at once and returns how many were taken
+uint32 NVIC_SPSCQueuePopBatch(NVIC_SPSCQueueType *Queue, NVIC_EventType *Events, uint32 Max_Events);
+
+// Attaches a cell array to an MPSC queue, returns FALSE if Capacity is not a power of two
+boolean NVIC_MPSCQueueInit(NVIC_MPSCQueueType *Queue, NVIC_MPSCCellType *Cells, uint32 Capacity);
+
+// Posts one event from any priority level, returns FALSE if the queue is full
+boolean NVIC_MPSCQueuePush(NVIC_MPSCQueueType *Queue, NVIC_EventType Event);
+
+// Takes one event, returns FALSE if no published event is available
+boolean NVIC_MPSCQueuePop(NVIC_MPSCQueueType *Queue, NVIC_EventType *Event);
+
+// Takes up to Max_Events published events at once and returns how many were taken
+uint32 NVIC_MPSCQueuePopBatch(NVIC_MPSCQueueType *Queue, NVIC_EventType *Events, uint32 Max_Events);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_QUEUE_H_ */
@@ -0,0 +1,299 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: nvic_sim.c
+ *
+ * Description: Source file for the host side NVIC/SysTick arbitration simulator
+ *
+ * Author: Ahmed Osama
+ *
+ ******************************************************************************/
+#include "nvic_sim.h"
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    uint16 Source;
+    uint32 Remaining_Cycles;
+} NVIC_SimActiveType;
+
+typedef struct
+{
+    const NVIC_SimEventType *Trace;
+    uint32 Trace_Length;
+    uint32 Trace_Index;
+    const NVIC_SimSysTickType *SysTick;
+    uint64 Next_SysTick;
+    boolean Pending[NVIC_SIM_SOURCES];
+    uint64 Arrival[NVIC_SIM_SOURCES];
+    uint32 Service[NVIC_SIM_SOURCES];
+    NVIC_SimActiveType Active[NVIC_SIM_MAX_DEPTH];
+    uint32 Depth;
+    uint32 Group_Shift;                 /* Low bits of a priority byte that only order pending requests */
+    NVIC_SimStatsType *Stats;
+} NVIC_SimStateType;
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+/* Implemented priority byte of a source, as the hardware would see it */
+static uint8 NVIC_SimPriority(uint16 Source)
+{
+    uint8 priority;
+
+    if (Source == NVIC_SIM_SYSTICK_SOURCE) {
+        priority = NVIC_SYSPRI_BYTE_REGS[NVIC_EXCEPTION_SYSPRI_BYTE(EXCEPTION_SYSTICK_TYPE)];
+    } else {
+        priority = NVIC_IPR_REGS[Source];
+    }
+    return (uint8)(priority & (NVIC_PRIORITY_LEVEL_MASK << NVIC_PRIORITY_SHIFT));
+}
+
+/* Exception number, breaks ties between equal priority bytes */
+static uint32 NVIC_SimExceptionNumber(uint16 Source)
+{
+    return (Source == NVIC_SIM_SYSTICK_SOURCE) ? 15 : (uint32)Source + NVIC_IRQ_VECTOR_OFFSET;
+}
+
+/* Time of the next request, trace or SysTick, or ~0 if there is none */
+static uint64 NVIC_SimNextArrival(const NVIC_SimStateType *State)
+{
+    uint64 next = ~(uint64)0;
+
+    if (State->Trace_Index < State->Trace_Length) {
+        next = State->Trace[State->Trace_Index].Time;
+    }
+    if ((State->SysTick != NULL_PTR) && (State->SysTick->Period_Cycles != 0) && (State->Next_SysTick < next)) {
+        next = State->Next_SysTick;
+    }
+    return next;
+}
+
+static void NVIC_SimRequest(NVIC_SimStateType *State, uint16 Source, uint64 Time, uint32 Service_Cycles)
+{
+    if (State->Pending[Source] != FALSE) {
+        State->Stats[Source].Lost++;
+        return;
+    }
+    State->Pending[Source] = TRUE;
+    State->Arrival[Source] = Time;
+    State->Service[Source] = Service_Cycles;
+}
+
+/* Latches every request made at or before Time */
+static void NVIC_SimAdmit(NVIC_SimStateType *State, uint64 Time)
+{
+    while (State->Trace_Index < State->Trace_Length && State->Trace[State->Trace_Index].Time <= Time) {
+        const NVIC_SimEventType *event = &State->Trace[State->Trace_Index++];
+        if (event->Source < NVIC_SIM_SOURCES) {
+            NVIC_SimRequest(State, event->Source, event->Time, event->Service_Cycles);
+        }
+    }
+    while ((State->SysTick != NULL_PTR) && (State->SysTick->Period_Cycles != 0) && (State->Next_SysTick <= Time)) {
+        NVIC_SimRequest(State, NVIC_SIM_SYSTICK_SOURCE, State->Next_SysTick, State->SysTick->Service_Cycles);
+        State->Next_SysTick += State->SysTick->Period_Cycles;
+    }
+}
+
+/* Highest priority pending source able to preempt the running handler, or NVIC_SIM_SOURCES if none */
+static uint16 NVIC_SimSelect(const NVIC_SimStateType *State)
+{
+    uint16 best = NVIC_SIM_SOURCES;
+    uint16 source;
+
+    for (source = 0; source < NVIC_SIM_SOURCES; source++) {
+        if (State->Pending[source] == FALSE) {
+            continue;
+        }
+        if ((State->Depth != 0) &&
+            ((NVIC_SimPriority(source) >> State->Group_Shift) >=
+             (NVIC_SimPriority(State->Active[State->Depth - 1].Source) >> State->Group_Shift))) {
+            continue;
+        }
+        if ((best == NVIC_SIM_SOURCES) || (NVIC_SimPriority(source) < NVIC_SimPriority(best)) ||
+            ((NVIC_SimPriority(source) == NVIC_SimPriority(best)) &&
+             (NVIC_SimExceptionNumber(source) < NVIC_SimExceptionNumber(best)))) {
+            best = source;
+        }
+    }
+    return best;
+}
+
+/* Enters the selected exception after Overhead cycles, a higher priority request landing
+ * during the entry takes it over (late arrival). Returns the first handler instruction time. */
+static uint64 NVIC_SimTake(NVIC_SimStateType *State, uint64 Time, uint32 Overhead, boolean Tail_Chain)
+{
+    uint16 target = NVIC_SimSelect(State);
+    uint64 start = Time + Overhead;
+    boolean late = FALSE;
+    uint64 next;
+    uint64 latency;
+    NVIC_SimStatsType *stats;
+
+    while ((next = NVIC_SimNextArrival(State)) < start) {
+        uint16 candidate;
+        NVIC_SimAdmit(State, next);
+        candidate = NVIC_SimSelect(State);
+        if (candidate != target) {
+            target = candidate;
+            late = TRUE;
+            if (next + NVIC_SIM_LATE_ARRIVAL_CYCLES > start) {
+                start = next + NVIC_SIM_LATE_ARRIVAL_CYCLES;
+            }
+        }
+    }
+
+    stats = &State->Stats[target];
+    latency = start - State->Arrival[target];
+    stats->Count++;
+    stats->Total_Latency_Cycles += latency;
+    if (latency > stats->Max_Latency_Cycles) {
+        stats->Max_Latency_Cycles = (uint32)latency;
+    }
+    stats->Histogram[(latency / NVIC_SIM_BUCKET_CYCLES < NVIC_SIM_BUCKETS) ?
+                     (uint32)(latency / NVIC_SIM_BUCKET_CYCLES) : (NVIC_SIM_BUCKETS - 1)]++;
+    if (late != FALSE) {
+        stats->Late_Arrivals++;
+    } else if (Tail_Chain != FALSE) {
+        stats->Tail_Chains++;
+    } else if (State->Depth != 0) {
+        stats->Preemptions++;
+    } else {
+        /* Taken from thread mode */
+    }
+
+    State->Pending[target] = FALSE;
+    State->Active[State->Depth].Source = target;
+    State->Active[State->Depth].Remaining_Cycles = State->Service[target];
+    State->Depth++;
+    return start;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_SimRun
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): Trace - Requests sorted by time
+ *                 Trace_Length - Number of requests in Trace
+ *                 SysTick - SysTick countdown model, NULL_PTR to leave it off
+ *                 Duration - Simulated time in cycles
+ * Parameters (inout): None
+ * Parameters (out): Stats - One slot per source, indexed by NVIC_IRQType
+ * Return value: None
+ * Description: Discrete event model of the NVIC: preemption on the group
+ *              priority set by PRIGROUP, ordering of pending requests by full
+ *              priority then exception number, tail-chaining, late arrival
+ *              and pop preemption during unstacking. Handlers always run to
+ *              their service time, thread mode is assumed idle.
+ *****************************************************************************/
+void NVIC_SimRun(const NVIC_SimEventType *Trace, uint32 Trace_Length, const NVIC_SimSysTickType *SysTick,
+                 uint64 Duration, NVIC_SimStatsType Stats[NVIC_SIM_SOURCES])
+{
+    NVIC_SimStateType state;
+    uint64 now = 0;
+    uint32 i;
+    uint8 *bytes = (uint8 *)Stats;
+
+    for (i = 0; i < sizeof(NVIC_SimStatsType) * NVIC_SIM_SOURCES; i++) {
+        bytes[i] = 0;
+    }
+    bytes = (uint8 *)&state;
+    for (i = 0; i < sizeof(state); i++) {
+        bytes[i] = 0;
+    }
+    state.Trace = Trace;
+    state.Trace_Length = Trace_Length;
+    state.SysTick = SysTick;
+    state.Next_SysTick = (SysTick != NULL_PTR) ? SysTick->Period_Cycles : 0;
+    state.Group_Shift = (uint32)NVIC_GetPriorityGrouping() + 1;
+    state.Stats = Stats;
+
+    while (now < Duration) {
+        NVIC_SimActiveType *top;
+        uint64 next = NVIC_SimNextArrival(&state);
+
+        if (state.Depth == 0) {
+            if (NVIC_SimSelect(&state) != NVIC_SIM_SOURCES) {
+                now = NVIC_SimTake(&state, now, NVIC_SIM_ENTRY_CYCLES, FALSE);
+            } else if (next == ~(uint64)0) {
+                break;
+            } else {
+                now = next;
+                NVIC_SimAdmit(&state, now);
+            }
+            continue;
+        }
+
+        top = &state.Active[state.Depth - 1];
+        if (next < now + top->Remaining_Cycles) {
+            /* A request lands while the handler runs, preempt it if it may */
+            top->Remaining_Cycles -= (uint32)(next - now);
+            now = next;
+            NVIC_SimAdmit(&state, now);
+            if (NVIC_SimSelect(&state) != NVIC_SIM_SOURCES) {
+                now = NVIC_SimTake(&state, now, NVIC_SIM_ENTRY_CYCLES, FALSE);
+            }
+            continue;
+        }
+
+        now += top->Remaining_Cycles;
+        state.Depth--;
+        NVIC_SimAdmit(&state, now);
+        if (NVIC_SimSelect(&state) != NVIC_SIM_SOURCES) {
+            now = NVIC_SimTake(&state, now, NVIC_SIM_TAIL_CHAIN_CYCLES, TRUE);
+            continue;
+        }
+
+        /* Exception return, a request able to preempt the frame being unstacked turns it into a tail-chain */
+        {
+            uint64 exit_end = now + NVIC_SIM_EXIT_CYCLES;
+            boolean chained = FALSE;
+
+            while ((next = NVIC_SimNextArrival(&state)) < exit_end) {
+                NVIC_SimAdmit(&state, next);
+                if (NVIC_SimSelect(&state) != NVIC_SIM_SOURCES) {
+                    now = NVIC_SimTake(&state, next, NVIC_SIM_TAIL_CHAIN_CYCLES, TRUE);
+                    chained = TRUE;
+                    break;
+                }
+            }
+            if (chained == FALSE) {
+                now = exit_end;
+            }
+        }
+    }
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_SimPercentile
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Stats - Stats slot filled by NVIC_SimRun
+ *                 Permille - 0 .. 1000, e.g. 990 for the 99th percentile
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Upper edge of the histogram bucket holding the
+ *               percentile, Max_Latency_Cycles for the open ended bucket
+ * Description: Percentile latency with NVIC_SIM_BUCKET_CYCLES resolution.
+ *****************************************************************************/
+uint32 NVIC_SimPercentile(const NVIC_SimStatsType *Stats, uint32 Permille)
+{
+    uint64 threshold = ((uint64)Stats->Count * Permille + 999) / 1000;
+    uint64 seen = 0;
+    uint32 bucket;
+
+    if (Stats->Count == 0) {
+        return 0;
+    }
+    for (bucket = 0; bucket < NVIC_SIM_BUCKETS - 1; bucket++) {
+        seen += Stats->Histogram[bucket];
+        if (seen >= threshold) {
+            return (bucket + 1) * NVIC_SIM_BUCKET_CYCLES;
+        }
+    }
+    return Stats->Max_Latency_Cycles;
+}
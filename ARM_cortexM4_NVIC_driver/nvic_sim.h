@@ -0,0 +1,108 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: nvic_sim.h
+ *
+ * Description: Header file for the host side NVIC/SysTick arbitration simulator
+ *
+ * Author: Ahmed Osama
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_SIM_H_
+#define NVIC_SIM_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "nvic.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/*
+ * Host builds only, see the root CMakeLists.txt: nvic.c is compiled against the
+ * register file in tests/stubs. Apply the priority configuration under test with
+ * NVIC_ApplyConfig or the NVIC_Set* services, the simulator reads priorities back
+ * from those registers. tests/nvic_sim_report runs a workload file through it.
+ */
+
+/* Cortex-M4 exception timing with zero wait state memory, in core cycles */
+#ifndef NVIC_SIM_ENTRY_CYCLES
+#define NVIC_SIM_ENTRY_CYCLES                12
+#endif
+#ifndef NVIC_SIM_EXIT_CYCLES
+#define NVIC_SIM_EXIT_CYCLES                 10
+#endif
+#ifndef NVIC_SIM_TAIL_CHAIN_CYCLES
+#define NVIC_SIM_TAIL_CHAIN_CYCLES           6
+#endif
+/* Vector fetch time left for a late arriving exception that takes over an entry in progress */
+#ifndef NVIC_SIM_LATE_ARRIVAL_CYCLES
+#define NVIC_SIM_LATE_ARRIVAL_CYCLES         6
+#endif
+
+/* Latency histogram, bucket n counts latencies in [n, n+1) * NVIC_SIM_BUCKET_CYCLES, the last one is open ended */
+#ifndef NVIC_SIM_BUCKETS
+#define NVIC_SIM_BUCKETS                     64
+#endif
+#ifndef NVIC_SIM_BUCKET_CYCLES
+#define NVIC_SIM_BUCKET_CYCLES               4
+#endif
+
+/* Sources: one per IRQ line plus one for SysTick */
+#define NVIC_SIM_SYSTICK_SOURCE              NVIC_IRQ_COUNT
+#define NVIC_SIM_SOURCES                     (NVIC_IRQ_COUNT + 1)
+
+/* Deepest possible preemption: one handler per preemption priority level */
+#define NVIC_SIM_MAX_DEPTH                   (1 << NVIC_PRIORITY_BITS)
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* One interrupt request of the workload trace */
+typedef struct
+{
+    uint64 Time;                        /* Request time in cycles, the trace is sorted by it */
+    uint16 Source;                      /* NVIC_IRQType value or NVIC_SIM_SYSTICK_SOURCE */
+    uint32 Service_Cycles;              /* Handler run time, exception overhead excluded */
+} NVIC_SimEventType;
+
+/* SysTick countdown, Period_Cycles = 0 leaves SysTick off */
+typedef struct
+{
+    uint32 Period_Cycles;               /* STRELOAD + 1 */
+    uint32 Service_Cycles;
+} NVIC_SimSysTickType;
+
+typedef struct
+{
+    uint32 Count;                       /* Handler runs */
+    uint32 Lost;                        /* Requests merged into one already pending */
+    uint32 Preemptions;                 /* Handler runs that preempted another handler */
+    uint32 Tail_Chains;                 /* Handler runs entered by tail-chaining */
+    uint32 Late_Arrivals;               /* Handler runs that took over the entry of a lower priority one */
+    uint32 Max_Latency_Cycles;          /* Request to first handler instruction */
+    uint64 Total_Latency_Cycles;
+    uint32 Histogram[NVIC_SIM_BUCKETS];
+} NVIC_SimStatsType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+// Runs a workload trace through the arbitration model for Duration cycles and fills one stats slot per source
+void NVIC_SimRun(const NVIC_SimEventType *Trace, uint32 Trace_Length, const NVIC_SimSysTickType *SysTick,
+                 uint64 Duration, NVIC_SimStatsType Stats[NVIC_SIM_SOURCES]);
+
+// Returns the latency in cycles below which Permille thousandths of a source's handler runs started
+uint32 NVIC_SimPercentile(const NVIC_SimStatsType *Stats, uint32 Permille);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_SIM_H_ */
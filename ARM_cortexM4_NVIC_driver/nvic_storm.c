@@ -0,0 +1,271 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: nvic_storm.c
+ *
+ * Description: Source file for the per IRQ interrupt storm detection and throttling
+ *
+ * Author: Ahmed Osama
+ *
+ ******************************************************************************/
+#include "nvic_storm.h"
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static NVIC_StormStatsType NVIC_StormStats[NVIC_IRQ_COUNT];
+static NVIC_HandlerType NVIC_StormHandlers[NVIC_IRQ_COUNT];
+static NVIC_StormCallBackType NVIC_StormCallBack = NULL_PTR;
+
+/* Throttled IRQs, walked at each window boundary instead of every IRQ line */
+static NVIC_IRQSetType NVIC_StormThrottled;
+
+static volatile uint32 NVIC_StormWindow;
+static uint32 NVIC_StormWindowTicks;
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+/* Common vector for monitored IRQs, finds the IRQ from IPSR and counts it before running its handler */
+static void NVIC_StormDispatch(void)
+{
+    uint32 irq;
+
+    NVIC_READ_IPSR(irq);
+    irq -= NVIC_IRQ_VECTOR_OFFSET;
+    NVIC_StormCount((NVIC_IRQType)irq);
+    NVIC_StormHandlers[irq]();
+}
+
+/* Re-enables the throttled IRQs whose backoff ended, called with the new window number */
+static void NVIC_StormResume(uint32 Window)
+{
+    uint32 word;
+    uint32 pending;
+    uint32 irq;
+    NVIC_StormStatsType *stats;
+    NVIC_CriticalStateType state;
+
+    for (word = 0; word < NVIC_IRQ_REG_COUNT; word++) {
+        pending = NVIC_StormThrottled.Words[word];
+        while (pending != 0) {
+            irq = (word * 32) + (31 - (uint32)__builtin_clz(pending));
+            pending &= ~NVIC_IRQ_BIT_MASK(irq);
+            stats = &NVIC_StormStats[irq];
+            if ((sint32)(Window - stats->Resume_Window) < 0) {
+                continue;
+            }
+            state = NVIC_EnterCritical();
+            NVIC_IRQSetRemove(&NVIC_StormThrottled, (NVIC_IRQType)irq);
+            stats->Throttled = FALSE;
+            NVIC_ExitCritical(state);
+            /* Drop the request latched while disabled, it belongs to the storm */
+            NVIC_ClearPending((NVIC_IRQType)irq);
+            NVIC_EnableIRQ((NVIC_IRQType)irq);
+            if (NVIC_StormCallBack != NULL_PTR) {
+                NVIC_StormCallBack((NVIC_IRQType)irq, FALSE);
+            }
+        }
+    }
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_StormInit
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Stops monitoring every IRQ and clears the counters. IRQs
+ *              currently throttled stay disabled.
+ *****************************************************************************/
+void NVIC_StormInit(void)
+{
+    uint32 irq;
+    NVIC_CriticalStateType state = NVIC_EnterCritical();
+
+    for (irq = 0; irq < NVIC_IRQ_COUNT; irq++) {
+        NVIC_StormStats[irq].Budget = NVIC_STORM_NO_BUDGET;
+        NVIC_StormStats[irq].Backoff_Windows = 0;
+        NVIC_StormStats[irq].Count = 0;
+        NVIC_StormStats[irq].Peak_Count = 0;
+        NVIC_StormStats[irq].Window = 0;
+        NVIC_StormStats[irq].Resume_Window = 0;
+        NVIC_StormStats[irq].Throttle_Count = 0;
+        NVIC_StormStats[irq].Current_Backoff = 0;
+        NVIC_StormStats[irq].Throttled = FALSE;
+    }
+    NVIC_IRQSetClear(&NVIC_StormThrottled);
+    NVIC_StormWindow = 0;
+    NVIC_StormWindowTicks = 0;
+
+    NVIC_ExitCritical(state);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_StormSetCallBack
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): CallBack - Function told about throttling changes, or NULL_PTR
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Lets the application switch to a degraded mode while an IRQ
+ *              is throttled, e.g. poll the peripheral from a slow task.
+ *****************************************************************************/
+void NVIC_StormSetCallBack(NVIC_StormCallBackType CallBack)
+{
+    NVIC_StormCallBack = CallBack;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_StormSetBudget
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Interrupt request number
+ *                 Budget - Interrupts allowed per window, NVIC_STORM_NO_BUDGET
+ *                          to stop monitoring
+ *                 Backoff_Windows - Windows the IRQ stays disabled after a storm
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Configures the storm limits of an IRQ.
+ *****************************************************************************/
+void NVIC_StormSetBudget(NVIC_IRQType IRQ_Num, uint16 Budget, uint16 Backoff_Windows)
+{
+    NVIC_StormStatsType *stats = &NVIC_StormStats[IRQ_Num];
+    NVIC_CriticalStateType state = NVIC_EnterCritical();
+
+    stats->Budget = Budget;
+    stats->Backoff_Windows = (Backoff_Windows == 0) ? 1 : Backoff_Windows;
+    stats->Current_Backoff = stats->Backoff_Windows;
+    stats->Count = 0;
+    stats->Window = NVIC_StormWindow;
+
+    NVIC_ExitCritical(state);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_StormRegisterHandler
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): IRQ_Num - Interrupt request number
+ *                 Handler - Function to run on the interrupt
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Points the IRQ vector at the storm filter, which needs the
+ *              vector table in SRAM (NVIC_RelocateVectorTable).
+ *****************************************************************************/
+void NVIC_StormRegisterHandler(NVIC_IRQType IRQ_Num, NVIC_HandlerType Handler)
+{
+    NVIC_StormHandlers[IRQ_Num] = Handler;
+    NVIC_RegisterHandler(IRQ_Num, NVIC_StormDispatch);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_StormCount
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Interrupt request number
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Counts one interrupt in the current window. The count of a
+ *              previous window is dropped lazily here, so closing a window
+ *              costs nothing per IRQ. Once over budget the IRQ is disabled,
+ *              and its backoff doubles if it storms again in the window it
+ *              was re-enabled in.
+ *****************************************************************************/
+void NVIC_StormCount(NVIC_IRQType IRQ_Num)
+{
+    NVIC_StormStatsType *stats = &NVIC_StormStats[IRQ_Num];
+    uint32 window = NVIC_StormWindow;
+    uint32 backoff;
+    NVIC_CriticalStateType state;
+
+    if (stats->Budget == NVIC_STORM_NO_BUDGET) {
+        return;
+    }
+    if (stats->Window != window) {
+        stats->Window = window;
+        stats->Count = 0;
+    }
+    stats->Count++;
+    if (stats->Count > stats->Peak_Count) {
+        stats->Peak_Count = stats->Count;
+    }
+    if ((stats->Count <= stats->Budget) || (stats->Throttled != FALSE)) {
+        return;
+    }
+
+    NVIC_DisableIRQ(IRQ_Num);
+    state = NVIC_EnterCritical();
+    if ((stats->Throttle_Count != 0) && (window == stats->Resume_Window)) {
+        /* Stormed again in the window it was re-enabled in */
+        backoff = (uint32)stats->Current_Backoff * 2;
+        stats->Current_Backoff = (uint16)((backoff > NVIC_STORM_MAX_BACKOFF_WINDOWS) ?
+                                          NVIC_STORM_MAX_BACKOFF_WINDOWS : backoff);
+    } else {
+        stats->Current_Backoff = stats->Backoff_Windows;
+    }
+    stats->Resume_Window = window + stats->Current_Backoff;
+    stats->Throttle_Count++;
+    stats->Throttled = TRUE;
+    NVIC_IRQSetAdd(&NVIC_StormThrottled, IRQ_Num);
+    NVIC_ExitCritical(state);
+
+    if (NVIC_StormCallBack != NULL_PTR) {
+        NVIC_StormCallBack(IRQ_Num, TRUE);
+    }
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_StormTick
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Closes the window every NVIC_STORM_WINDOW_TICKS calls and
+ *              re-enables the IRQs whose backoff ended. Only throttled IRQs
+ *              are visited.
+ *****************************************************************************/
+void NVIC_StormTick(void)
+{
+    uint32 window;
+    NVIC_CriticalStateType state;
+
+    if (++NVIC_StormWindowTicks < NVIC_STORM_WINDOW_TICKS) {
+        return;
+    }
+    NVIC_StormWindowTicks = 0;
+
+    state = NVIC_EnterCritical();
+    window = NVIC_StormWindow + 1;
+    NVIC_StormWindow = window;
+    NVIC_ExitCritical(state);
+
+    NVIC_StormResume(window);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_StormGetStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Interrupt request number
+ * Parameters (inout): None
+ * Parameters (out): Stats - Copy of the IRQ counters
+ * Return value: None
+ * Description: Copies the counters of an IRQ with exceptions masked.
+ *****************************************************************************/
+void NVIC_StormGetStats(NVIC_IRQType IRQ_Num, NVIC_StormStatsType *Stats)
+{
+    NVIC_CriticalStateType state = NVIC_EnterCritical();
+    *Stats = NVIC_StormStats[IRQ_Num];
+    NVIC_ExitCritical(state);
+}
@@ -0,0 +1,87 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: nvic_storm.h
+ *
+ * Description: Header file for the per IRQ interrupt storm detection and throttling
+ *
+ * Author: Ahmed Osama
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_STORM_H_
+#define NVIC_STORM_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "nvic.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Accounting window in SysTick periods, NVIC_StormTick closes a window every this many calls */
+#ifndef NVIC_STORM_WINDOW_TICKS
+#define NVIC_STORM_WINDOW_TICKS              10
+#endif
+
+/* Upper bound of the backoff, which doubles each time an IRQ storms again in the window it was re-enabled in */
+#ifndef NVIC_STORM_MAX_BACKOFF_WINDOWS
+#define NVIC_STORM_MAX_BACKOFF_WINDOWS       1000
+#endif
+
+/* Budget value meaning "not monitored" */
+#define NVIC_STORM_NO_BUDGET                 0
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Called from the storming IRQ with Throttled = TRUE, and from SysTick_Handler with FALSE when it is re-enabled */
+typedef void (*NVIC_StormCallBackType)(NVIC_IRQType IRQ_Num, boolean Throttled);
+
+typedef struct
+{
+    uint16 Budget;                      /* Interrupts allowed per window */
+    uint16 Backoff_Windows;             /* Windows the IRQ stays disabled after its first storm */
+    uint16 Count;                       /* Interrupts counted in Window */
+    uint16 Peak_Count;                  /* Highest count seen in any window */
+    uint32 Window;                      /* Window Count belongs to */
+    uint32 Resume_Window;               /* Window the IRQ is re-enabled at while throttled */
+    uint32 Throttle_Count;              /* Storms detected */
+    uint16 Current_Backoff;             /* Backoff applied to the last storm */
+    boolean Throttled;
+} NVIC_StormStatsType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+// Stops monitoring every IRQ and clears the counters
+void NVIC_StormInit(void);
+
+// Sets the callback run when an IRQ is throttled or re-enabled
+void NVIC_StormSetCallBack(NVIC_StormCallBackType CallBack);
+
+// Monitors an IRQ with a budget per window and a backoff, NVIC_STORM_NO_BUDGET stops monitoring it
+void NVIC_StormSetBudget(NVIC_IRQType IRQ_Num, uint16 Budget, uint16 Backoff_Windows);
+
+// Installs a monitored IRQ handler, the hardware enters the storm filter which counts the call then runs Handler
+void NVIC_StormRegisterHandler(NVIC_IRQType IRQ_Num, NVIC_HandlerType Handler);
+
+// Counts one interrupt of an IRQ and throttles it when over budget, for handlers not installed through the filter
+void NVIC_StormCount(NVIC_IRQType IRQ_Num);
+
+// Advances the accounting window and re-enables the IRQs whose backoff ended, called from SysTick_Handler
+void NVIC_StormTick(void);
+
+// Copies the counters of an IRQ
+void NVIC_StormGetStats(NVIC_IRQType IRQ_Num, NVIC_StormStatsType *Stats);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_STORM_H_ */
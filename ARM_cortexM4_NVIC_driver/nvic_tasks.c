@@ -0,0 +1,140 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: nvic_tasks.c
+ *
+ * Description: Source file for the run-to-completion tasks scheduled by the NVIC on spare IRQ lines
+ *
+ * Author: Ahmed Osama
+ *
+ ******************************************************************************/
+#include "nvic_tasks.h"
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static NVIC_TaskType *NVIC_TaskByIRQ[NVIC_IRQ_COUNT];
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+/* Common vector of every task IRQ, runs the task on each queued event to completion */
+static void NVIC_TaskDispatch(void)
+{
+    NVIC_EventType events[NVIC_TASK_BATCH_SIZE];
+    NVIC_TaskType *task;
+    uint32 count;
+    uint32 i;
+    uint32 irq;
+
+    NVIC_READ_IPSR(irq);
+    task = NVIC_TaskByIRQ[irq - NVIC_IRQ_VECTOR_OFFSET];
+    do {
+        count = NVIC_MPSCQueuePopBatch(&task->Queue, events, NVIC_TASK_BATCH_SIZE);
+        for (i = 0; i < count; i++) {
+            task->Handler(events[i], task->Context);
+        }
+    } while (count == NVIC_TASK_BATCH_SIZE);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_TaskCreate
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): IRQ_Num - Spare IRQ line with no peripheral behind it
+ *                 Priority - Task priority, programmed with NVIC_SetPriorityIRQ
+ *                 Handler - Run-to-completion function called once per event
+ *                 Context - Argument passed to Handler
+ *                 Cells - Storage for the task event queue
+ *                 Capacity - Number of cells, a power of two
+ * Parameters (inout): None
+ * Parameters (out): Task - Task to initialize
+ * Return value: boolean - FALSE if Capacity is not a power of two
+ * Description: The NVIC then does the scheduling: a posted task runs when its
+ *              priority is the highest pending, preempts lower ones and
+ *              tail-chains into the next ready task, all on the main stack.
+ *              NVIC_RelocateVectorTable must have been called first.
+ *****************************************************************************/
+boolean NVIC_TaskCreate(NVIC_TaskType *Task, NVIC_IRQType IRQ_Num, NVIC_IRQPriorityType Priority,
+                        NVIC_TaskHandlerType Handler, void *Context,
+                        NVIC_MPSCCellType *Cells, uint32 Capacity)
+{
+    if (NVIC_MPSCQueueInit(&Task->Queue, Cells, Capacity) == FALSE) {
+        return FALSE;
+    }
+    Task->IRQ_Num = IRQ_Num;
+    Task->Priority = Priority;
+    Task->Handler = Handler;
+    Task->Context = Context;
+
+    NVIC_TaskByIRQ[IRQ_Num] = Task;
+    NVIC_DisableIRQ(IRQ_Num);
+    NVIC_ClearPending(IRQ_Num);
+    NVIC_SetPriorityIRQ(IRQ_Num, Priority);
+    NVIC_RegisterHandler(IRQ_Num, NVIC_TaskDispatch);
+    NVIC_EnableIRQ(IRQ_Num);
+    return TRUE;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_TaskPost
+ * Sync/Async: Asynchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Event - Event for the task
+ * Parameters (inout): Task - Destination task
+ * Parameters (out): None
+ * Return value: boolean - FALSE if the task queue is full, the IRQ is not pended
+ * Description: Lock-free post. If the task has a higher priority than the
+ *              caller it runs as soon as this function returns.
+ *****************************************************************************/
+boolean NVIC_TaskPost(NVIC_TaskType *Task, NVIC_EventType Event)
+{
+    if (NVIC_MPSCQueuePush(&Task->Queue, Event) == FALSE) {
+        return FALSE;
+    }
+    NVIC_TriggerIRQ(Task->IRQ_Num);
+    return TRUE;
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_TaskLock
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Task - Highest priority task sharing the protected data
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_CriticalStateType - State for NVIC_TaskUnlock
+ * Description: Raises BASEPRI to the task priority (stack resource policy),
+ *              tasks above it keep preempting. A BASEPRI of 0 masks nothing,
+ *              so a Priority_0 task falls back to PRIMASK and the returned
+ *              state carries NVIC_TASK_LOCK_PRIMASK_FLAG.
+ *****************************************************************************/
+NVIC_CriticalStateType NVIC_TaskLock(const NVIC_TaskType *Task)
+{
+    if ((Task->Priority & NVIC_PRIORITY_LEVEL_MASK) == Priority_0) {
+        return NVIC_EnterCritical() | NVIC_TASK_LOCK_PRIMASK_FLAG;
+    }
+    return NVIC_EnterCriticalCeiling(Task->Priority);
+}
+
+/*****************************************************************************
+ * Service Name: NVIC_TaskUnlock
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Saved_State - Value returned by NVIC_TaskLock
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Restores the BASEPRI value, or the PRIMASK state for a
+ *              Priority_0 task, saved by NVIC_TaskLock.
+ *****************************************************************************/
+void NVIC_TaskUnlock(NVIC_CriticalStateType Saved_State)
+{
+    if ((Saved_State & NVIC_TASK_LOCK_PRIMASK_FLAG) != 0) {
+        NVIC_ExitCritical(Saved_State & ~(NVIC_CriticalStateType)NVIC_TASK_LOCK_PRIMASK_FLAG);
+    } else {
+        NVIC_ExitCriticalCeiling(Saved_State);
+    }
+}
@@ -0,0 +1,72 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: nvic_tasks.h
+ *
+ * Description: Header file for the run-to-completion tasks scheduled by the NVIC on spare IRQ lines
+ *
+ * Author: Ahmed Osama
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_TASKS_H_
+#define NVIC_TASKS_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "nvic.h"
+#include "nvic_queue.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Events taken from a task queue per batch while the task runs */
+#ifndef NVIC_TASK_BATCH_SIZE
+#define NVIC_TASK_BATCH_SIZE                 8
+#endif
+
+/* Marks a NVIC_TaskLock state that holds PRIMASK rather than BASEPRI, BASEPRI never exceeds 0xFF */
+#define NVIC_TASK_LOCK_PRIMASK_FLAG          0x100
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef void (*NVIC_TaskHandlerType)(NVIC_EventType Event, void *Context);
+
+/* Caller-owned task, one spare IRQ line per task, the IRQ priority is the task priority */
+typedef struct
+{
+    NVIC_IRQType IRQ_Num;
+    NVIC_IRQPriorityType Priority;
+    NVIC_TaskHandlerType Handler;
+    void *Context;
+    NVIC_MPSCQueueType Queue;
+} NVIC_TaskType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+// Binds a task to a spare IRQ line, sets its priority and enables it, returns FALSE if Capacity is not a power of two
+boolean NVIC_TaskCreate(NVIC_TaskType *Task, NVIC_IRQType IRQ_Num, NVIC_IRQPriorityType Priority,
+                        NVIC_TaskHandlerType Handler, void *Context,
+                        NVIC_MPSCCellType *Cells, uint32 Capacity);
+
+// Queues an event for a task and pends its IRQ, callable from any context, returns FALSE if the queue is full
+boolean NVIC_TaskPost(NVIC_TaskType *Task, NVIC_EventType Event);
+
+// Stops every task up to Task's priority from preempting the caller (priority ceiling), masks everything for a Priority_0 task,
+// returns the state to restore
+NVIC_CriticalStateType NVIC_TaskLock(const NVIC_TaskType *Task);
+
+// Ends a section started by NVIC_TaskLock
+void NVIC_TaskUnlock(NVIC_CriticalStateType Saved_State);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* NVIC_TASKS_H_ */
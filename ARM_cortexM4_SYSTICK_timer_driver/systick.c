@@ -1,131 +1,603 @@
-/******************************************************************************
- *
- * Module: timer
- *
- * File Name: systick_timer.c
- *
- * Description: Header file for the ARM Cortex M4 timer driver
- *
- * Author: Ahmed Osama
- *
- ******************************************************************************/
-
-#include "SysTick.h"
-#include "common_macros.h"
-
-/*****************************************************************************
- * Service Name: SysTick_Init
- * Sync/Async: Synchronous
- * Reentrancy: Non-reentrant
- * Parameters (in): a_TimeInMilliSeconds - Time period in milliseconds
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: Initializes the SysTick timer with the given time period.
- *****************************************************************************/
-void SysTick_Init(uint16 a_TimeInMilliSeconds) {
-    Enable_Exceptions();
-    Enable_Faults();
-    SYSTICK_CTRL_REG &= ~0x7;  // Clear SysTick control register
-    SYSTICK_CURRENT_REG = 0;  // Clear current register
-    SYSTICK_RELOAD_REG = ((a_TimeInMilliSeconds -1)* tick_per_sec) / 1000;
-    SYSTICK_CTRL_REG |= 0x7;  // Enable SysTick timer, interrupt, and system clock
-}
-
-/*****************************************************************************
- * Service Name: SysTick_Handler
- * Sync/Async: Synchronous
- * Reentrancy: Reentrant
- * Parameters (in): None
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: SysTick interrupt handler to execute the callback function.
- *****************************************************************************/
-void SysTick_Handler(void) {
-    // Execute the callback if available
-    if (SYSTICK_call_back != NULL_PTR) {
-        (*SYSTICK_call_back)();
-    }
-}
-
-/*****************************************************************************
- * Service Name: SysTick_SetCallBack
- * Sync/Async: Synchronous
- * Reentrancy: Reentrant
- * Parameters (in): Ptr2Func - Pointer to the callback function
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: Sets the callback function for the SysTick timer.
- *****************************************************************************/
-void SysTick_SetCallBack(volatile void (*Ptr2Func) (void))
-{
-    SYSTICK_call_back = Ptr2Func ;
-}
-
-/*****************************************************************************
- * Service Name: SysTick_Stop
- * Sync/Async: Synchronous
- * Reentrancy: Non-reentrant
- * Parameters (in): None
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: Stops the SysTick timer.
- *****************************************************************************/
-void SysTick_Stop(void)
-{
-    SYSTICK_CTRL_REG&=~(1<<0);   // Disable SysTick
-}
-
-/*****************************************************************************
- * Service Name: SysTick_Start
- * Sync/Async: Synchronous
- * Reentrancy: Non-reentrant
- * Parameters (in): None
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: Starts the SysTick timer.
- *****************************************************************************/
-void SysTick_Start(void)
-{
-    SYSTICK_CTRL_REG|=(1<<0);   // Enable SysTick
-}
-
-/*****************************************************************************
- * Service Name: SysTick_DeInit
- * Sync/Async: Synchronous
- * Reentrancy: Non-reentrant
- * Parameters (in): None
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: Deinitializes the SysTick timer and clears its registers.
- *****************************************************************************/
-void SysTick_DeInit(void)
-{
-    SYSTICK_CTRL_REG&=0x8;   // Clear SysTick CTRL register
-    SYSTICK_RELOAD_REG=0;
-    SYSTICK_CURRENT_REG=0;
-}
-
-/*****************************************************************************
- * Service Name: SysTick_StartBusyWait
- * Sync/Async: Synchronous
- * Reentrancy: Non-reentrant
- * Parameters (in): a_TimeInMilliSeconds - Time period in milliseconds
- * Parameters (inout): None
- * Parameters (out): None
- * Return value: None
- * Description: Starts the SysTick timer in busy-wait mode for the specified time.
- *****************************************************************************/
-void SysTick_StartBusyWait(uint16 a_TimeInMilliSeconds)
-{
-    SYSTICK_CTRL_REG&=~(1<<1);  // Disable interrupt
-    SYSTICK_CTRL_REG|=((1<<0)|(1<<2));  // Enable SysTick and system clock
-    SYSTICK_RELOAD_REG=a_TimeInMilliSeconds * 15999;
-    SYSTICK_CURRENT_REG=0;
-    while(!(SYSTICK_CTRL_REG&(1<<16)));  // Wait for the COUNTFLAG
-}
+/******************************************************************************
+ *
+ * Module: timer
+ *
+ * File Name: systick_timer.c
+ *
+ * Description: Header file for the ARM Cortex M4 timer driver
+ *
+ * Author: Ahmed Osama
+ *
+ ******************************************************************************/
+
+#include "systick.h"
+#include "common_macros.h"
+#include "nvic.h"
+#include "nvic_profiler.h"
+
+#if SYSTICK_TIMERS_ENABLED
+#include "systick_timers.h"
+#endif
+
+#if SYSTICK_SCHEDULE_ENABLED
+#include "systick_schedule.h"
+#endif
+
+#if SYSTICK_STORM_ENABLED
+#include "nvic_storm.h"
+#endif
+
+#if SYSTICK_COALESCE_ENABLED
+#include "nvic_coalesce.h"
+#endif
+
+#if SYSTICK_KERNEL_ENABLED
+#include "kernel.h"
+#endif
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Sequence bit set by SysTick_Handler on entry and cleared by its publish: the exception is already active, so
+ * PENDSTSET is clear, but the wrap that raised it is not in the time base yet. Sharing the sequence word makes
+ * clearing it and publishing the new base one store. */
+#define SYSTICK_TIME_SEQ_WRAP_PENDING        0x80000000
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+/* Two copies of the time base: the handler fills the copy readers are not using,
+ * then publishes it by incrementing the sequence, so readers never wait on the writer */
+static volatile SysTick_TimeType SysTick_TimeBuffer[2];
+static volatile uint32 SysTick_TimeSeq = 0;
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+/* Adds a_Ticks full periods of the current reload to the time base */
+static void SysTick_TimeAdvance(uint32 a_Ticks)
+{
+    uint32 seq = SysTick_TimeSeq;
+    uint32 tick_cycles = SYSTICK_RELOAD_REG + 1;
+    volatile const SysTick_TimeType *old_time = &SysTick_TimeBuffer[seq & 1];
+    volatile SysTick_TimeType *new_time = &SysTick_TimeBuffer[(seq + 1) & 1];
+    uint64 cycles = (uint64)a_Ticks * tick_cycles + old_time->Remainder_Cycles;
+
+    new_time->Cycles = old_time->Cycles + (uint64)a_Ticks * tick_cycles;
+    new_time->Ticks = old_time->Ticks + a_Ticks;
+    if (cycles <= 0xFFFFFFFF) {
+        /* Single tick path, 32-bit division only */
+        new_time->Microseconds = old_time->Microseconds + ((uint32)cycles / SYSTICK_CYCLES_PER_US);
+        new_time->Remainder_Cycles = (uint32)cycles % SYSTICK_CYCLES_PER_US;
+    } else {
+        new_time->Microseconds = old_time->Microseconds + (cycles / SYSTICK_CYCLES_PER_US);
+        new_time->Remainder_Cycles = (uint32)(cycles % SYSTICK_CYCLES_PER_US);
+    }
+    SysTick_TimeSeq = (seq + 1) & ~SYSTICK_TIME_SEQ_WRAP_PENDING;
+}
+
+/* Busy-waits a_Cycles core cycles by accumulating the SysTick counter's progress across wraps.
+ * Runs on whatever period is programmed. If SysTick is off, a free-running counter is started for
+ * the wait and CTRL and RELOAD are put back afterwards, so the counter is left stopped as found. */
+static void SysTick_DelayCyclesLong(uint64 a_Cycles)
+{
+    uint32 period;
+    uint32 last;
+    uint32 now;
+    uint32 saved_ctrl;
+    uint32 saved_reload = 0;
+    uint64 waited = SYSTICK_DELAY_OVERHEAD_CYCLES;
+
+    saved_ctrl = SYSTICK_CTRL_REG;
+    if (!(saved_ctrl & SYSTICK_CTRL_ENABLE_MASK)) {
+        saved_reload = SYSTICK_RELOAD_REG;
+        SYSTICK_RELOAD_REG = SYSTICK_MAX_RELOAD;
+        SYSTICK_CURRENT_REG = 0;
+        SYSTICK_CTRL_REG = SYSTICK_CTRL_CLK_SRC_MASK | SYSTICK_CTRL_ENABLE_MASK;
+    }
+    period = SYSTICK_RELOAD_REG + 1;
+    last = SYSTICK_CURRENT_REG;
+    while (waited < a_Cycles) {
+        now = SYSTICK_CURRENT_REG;
+        /* The counter counts down and reloads to period - 1 after reaching 0 */
+        waited += (now <= last) ? (last - now) : (last + period - now);
+        last = now;
+    }
+    if (!(saved_ctrl & SYSTICK_CTRL_ENABLE_MASK)) {
+        /* Stop first so no wrap can pend a tick, CURRENT is cleared so the next enable starts a full period */
+        SYSTICK_CTRL_REG = saved_ctrl & ~SYSTICK_CTRL_COUNTFLAG_MASK;
+        SYSTICK_RELOAD_REG = saved_reload;
+        SYSTICK_CURRENT_REG = 0;
+    }
+}
+
+/* Copies a consistent time base and returns the cycles elapsed since it */
+static uint32 SysTick_TimeRead(SysTick_TimeType *a_Time)
+{
+    uint32 seq;
+    uint32 reload;
+    uint32 current;
+    uint32 in_tick;
+
+    do {
+        seq = SysTick_TimeSeq;
+        *a_Time = SysTick_TimeBuffer[seq & 1];
+        reload = SYSTICK_RELOAD_REG;
+        current = SYSTICK_CURRENT_REG;
+        in_tick = reload - current;
+        if ((seq & SYSTICK_TIME_SEQ_WRAP_PENDING) || (NVIC_ICSR_REG & NVIC_ICSR_PENDSTSET_MASK)) {
+            /* The counter wrapped but SysTick_Handler has not published it yet, re-read after the wrap */
+            in_tick = reload + 1 + reload - SYSTICK_CURRENT_REG;
+        }
+    } while (seq != SysTick_TimeSeq);
+
+    return in_tick;
+}
+
+/* Accounts for a_Ticks ticks that produced no interrupt. The timer wheel moves in spans that end
+ * before its next expiry or cascade and those ticks are replayed through SysTick_TimerTick, so no
+ * timer is missed however long the sleep was. A task whose run or a batch whose timeout was slept
+ * through is released on the next tick. */
+static void SysTick_CarryTicks(uint32 a_Ticks)
+{
+#if SYSTICK_TIMERS_ENABLED
+    uint32 span;
+#endif
+
+#if SYSTICK_SCHEDULE_ENABLED
+    SysTick_ScheduleSkip(a_Ticks);
+#endif
+#if SYSTICK_COALESCE_ENABLED
+    NVIC_CoalesceSkip(a_Ticks);
+#endif
+#if SYSTICK_TIMERS_ENABLED
+    while (a_Ticks > 0) {
+        span = SysTick_TimerTicksToNext() - 1;
+        if (span == 0) {
+            SysTick_TimeAdvance(1);
+            SysTick_TimerTick();
+            a_Ticks--;
+        } else {
+            if (span > a_Ticks) {
+                span = a_Ticks;
+            }
+            SysTick_TimeAdvance(span);
+            SysTick_TimerSkip(span);
+            a_Ticks -= span;
+        }
+    }
+#else
+    SysTick_TimeAdvance(a_Ticks);
+#endif
+}
+
+/* Restarts the stopped counter after a_Elapsed cycles went by without ticks, starting a_Current
+ * cycles before a tick was due. The counter is put back in phase with the a_TickCycles period,
+ * the whole ticks but the last are accounted here and the last one is left pending so
+ * SysTick_Handler processes it normally. Returns the number of whole ticks elapsed. */
+static uint32 SysTick_CarryElapsed(uint32 a_TickCycles, uint32 a_Current, uint64 a_Elapsed)
+{
+    uint32 elapsed_ticks;
+    uint32 remainder;
+
+    /* Split the elapsed cycles into whole ticks and the cycles left until the next tick */
+    if (a_Elapsed < a_Current) {
+        elapsed_ticks = 0;
+        remainder = a_Current - (uint32)a_Elapsed;
+    } else {
+        elapsed_ticks = 1 + (uint32)((a_Elapsed - a_Current) / a_TickCycles);
+        remainder = a_TickCycles - (uint32)((a_Elapsed - a_Current) % a_TickCycles);
+    }
+
+    SYSTICK_RELOAD_REG = remainder - 1;
+    SYSTICK_CURRENT_REG = 0;
+    SYSTICK_CTRL_REG |= SYSTICK_CTRL_ENABLE_MASK;
+    SYSTICK_RELOAD_REG = a_TickCycles - 1;  /* Taken at the next wrap, the first period is already loaded */
+
+    if (elapsed_ticks > 0) {
+        SysTick_CarryTicks(elapsed_ticks - 1);
+        NVIC_ICSR_REG = NVIC_ICSR_PENDSTSET_MASK;
+    }
+    return elapsed_ticks;
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_TimeInMilliSeconds - Time period in milliseconds
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Initializes the SysTick timer with the given time period.
+ *****************************************************************************/
+void SysTick_Init(uint16 a_TimeInMilliSeconds) {
+    Enable_Exceptions();
+    Enable_Faults();
+    SYSTICK_CTRL_REG &= ~0x7;  // Clear SysTick control register
+    SYSTICK_CURRENT_REG = 0;  // Clear current register
+    SYSTICK_RELOAD_REG = ((a_TimeInMilliSeconds -1)* tick_per_sec) / 1000;
+    SYSTICK_CTRL_REG |= 0x7;  // Enable SysTick timer, interrupt, and system clock
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_Handler
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: SysTick interrupt handler, advances the time base and the
+ *              software timers and executes the callback function.
+ *****************************************************************************/
+void SysTick_Handler(void) {
+    SysTick_TimeSeq |= SYSTICK_TIME_SEQ_WRAP_PENDING;  // Readers preempting us count the wrap until it is published
+#if NVIC_PROFILER_ENABLED
+    uint32 entry_latency = SYSTICK_RELOAD_REG - SYSTICK_CURRENT_REG;   // Cycles since the counter wrapped
+#endif
+    NVIC_PROFILER_HANDLER_ENTER();
+    SysTick_TimeAdvance(1);
+#if SYSTICK_TIMERS_ENABLED
+    SysTick_TimerTick();
+#endif
+#if SYSTICK_SCHEDULE_ENABLED
+    SysTick_ScheduleTick();
+#endif
+#if SYSTICK_STORM_ENABLED
+    NVIC_StormTick();
+#endif
+#if SYSTICK_COALESCE_ENABLED
+    NVIC_CoalesceTick();
+#endif
+#if SYSTICK_KERNEL_ENABLED
+    Kernel_Tick();
+#endif
+    // Execute the callback if available
+    if (SYSTICK_call_back != NULL_PTR) {
+        (*SYSTICK_call_back)();
+    }
+    NVIC_PROFILER_HANDLER_EXIT(NVIC_PROFILER_SYSTICK_INDEX, entry_latency);
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_SetCallBack
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Ptr2Func - Pointer to the callback function
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Sets the callback function for the SysTick timer.
+ *****************************************************************************/
+void SysTick_SetCallBack(volatile void (*Ptr2Func) (void))
+{
+    SYSTICK_call_back = Ptr2Func ;
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_Stop
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Stops the SysTick timer.
+ *****************************************************************************/
+void SysTick_Stop(void)
+{
+    SYSTICK_CTRL_REG&=~(1<<0);   // Disable SysTick
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_Start
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Starts the SysTick timer.
+ *****************************************************************************/
+void SysTick_Start(void)
+{
+    SYSTICK_CTRL_REG|=(1<<0);   // Enable SysTick
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_DeInit
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Deinitializes the SysTick timer and clears its registers.
+ *****************************************************************************/
+void SysTick_DeInit(void)
+{
+    SYSTICK_CTRL_REG&=0x8;   // Clear SysTick CTRL register
+    SYSTICK_RELOAD_REG=0;
+    SYSTICK_CURRENT_REG=0;
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_StartBusyWait
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_TimeInMilliSeconds - Time period in milliseconds
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Busy-waits for the specified time at SYSTICK_CORE_CLOCK_HZ,
+ *              without changing the periodic SysTick configuration.
+ *****************************************************************************/
+void SysTick_StartBusyWait(uint16 a_TimeInMilliSeconds)
+{
+    SysTick_DelayCyclesLong((uint64)a_TimeInMilliSeconds * (SYSTICK_CORE_CLOCK_HZ / 1000));
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_DelayCycles
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Cycles - Number of core cycles to wait
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Busy-waits at least a_Cycles cycles (minus the calibrated
+ *              call overhead). The error is bounded by one polling loop
+ *              iteration as long as the caller is not preempted for more
+ *              than a full SysTick period, which only lengthens the wait.
+ *              The periodic tick keeps running undisturbed, a stopped
+ *              counter is left stopped with its configuration intact.
+ *****************************************************************************/
+void SysTick_DelayCycles(uint32 a_Cycles)
+{
+    SysTick_DelayCyclesLong(a_Cycles);
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_DelayMicroseconds
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Microseconds - Number of microseconds to wait
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Busy-waits a_Microseconds at SYSTICK_CORE_CLOCK_HZ. Waits
+ *              longer than the 24-bit reload are handled by counting wraps.
+ *****************************************************************************/
+void SysTick_DelayMicroseconds(uint32 a_Microseconds)
+{
+    SysTick_DelayCyclesLong((uint64)a_Microseconds * SYSTICK_CYCLES_PER_US);
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_IdleTicks
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Ticks until the next tick with work, 0xFFFFFFFF if
+ *               no enabled service has any
+ * Description: Lowest of the TicksToNext bounds of the services compiled
+ *              into SysTick_Handler (timers, task table, coalescer timeouts),
+ *              the argument to pass to SysTick_TicklessIdle.
+ *****************************************************************************/
+uint32 SysTick_IdleTicks(void)
+{
+    uint32 idle_ticks = 0xFFFFFFFF;
+    uint32 ticks;
+
+#if SYSTICK_TIMERS_ENABLED
+    ticks = SysTick_TimerTicksToNext();
+    idle_ticks = (ticks < idle_ticks) ? ticks : idle_ticks;
+#endif
+#if SYSTICK_SCHEDULE_ENABLED
+    ticks = SysTick_ScheduleTicksToNext();
+    idle_ticks = (ticks < idle_ticks) ? ticks : idle_ticks;
+#endif
+#if SYSTICK_COALESCE_ENABLED
+    ticks = NVIC_CoalesceTicksToNext();
+    idle_ticks = (ticks < idle_ticks) ? ticks : idle_ticks;
+#endif
+    (void)ticks;
+    return idle_ticks;
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_TicklessIdle
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_IdleTicks - Ticks with nothing to do, normally
+ *                               SysTick_IdleTicks()
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Number of ticks that elapsed while sleeping
+ * Description: Sleeps through up to a_IdleTicks periods with a single SysTick
+ *              interrupt instead of one per period. Sleeps longer than the
+ *              24-bit reload are chained. On wake the elapsed time is rebuilt
+ *              from SYSTICK_CURRENT_REG, including the cycles counted past a
+ *              wrap before the counter is stopped, the periodic tick is
+ *              restarted in phase with the original period, and the last
+ *              elapsed tick is left pending so SysTick_Handler processes it
+ *              normally.
+ *****************************************************************************/
+uint32 SysTick_TicklessIdle(uint32 a_IdleTicks)
+{
+    uint32 tick_cycles;
+    uint32 current;
+    uint32 chunk;
+    uint32 ctrl;
+    uint32 counted;
+    uint32 elapsed_ticks;
+    uint64 remaining;
+    uint64 elapsed = 0;
+    NVIC_CriticalStateType state;
+
+    if (a_IdleTicks < 2) {
+        Wait_For_Interrupt();
+        return 0;
+    }
+
+    state = NVIC_EnterCritical();
+    tick_cycles = SYSTICK_RELOAD_REG + 1;
+    SYSTICK_CTRL_REG &= ~SYSTICK_CTRL_ENABLE_MASK;
+    current = SYSTICK_CURRENT_REG;
+    if ((current == 0) || (NVIC_ICSR_REG & NVIC_ICSR_PENDSTSET_MASK)) {
+        /* A tick is due right now, let it run */
+        SYSTICK_CTRL_REG |= SYSTICK_CTRL_ENABLE_MASK;
+        NVIC_ExitCritical(state);
+        return 0;
+    }
+
+    remaining = (uint64)current + (uint64)(a_IdleTicks - 1) * tick_cycles;
+    do {
+        chunk = (remaining > ((uint64)SYSTICK_MAX_RELOAD + 1)) ? (SYSTICK_MAX_RELOAD + 1) : (uint32)remaining;
+        SYSTICK_RELOAD_REG = chunk - 1;
+        SYSTICK_CURRENT_REG = 0;
+        SYSTICK_CTRL_REG |= SYSTICK_CTRL_ENABLE_MASK;
+        Data_Sync_Barrier();
+        Wait_For_Interrupt();       /* Wakes on any pending interrupt even with PRIMASK set */
+        Inst_Sync_Barrier();
+        ctrl = SYSTICK_CTRL_REG;    /* Reading CTRL clears COUNTFLAG */
+        SYSTICK_CTRL_REG = ctrl & ~SYSTICK_CTRL_ENABLE_MASK;
+        if (ctrl & SYSTICK_CTRL_COUNTFLAG_MASK) {
+            /* The counter reloaded at the wrap and kept counting until it was stopped above */
+            counted = SYSTICK_CURRENT_REG;
+            counted = chunk + ((counted != 0) ? (chunk - counted) : 0);
+            elapsed += counted;
+            remaining = (remaining > counted) ? (remaining - counted) : 0;
+            NVIC_ICSR_REG = NVIC_ICSR_PENDSTCLR_MASK;
+        } else {
+            /* Woken early by another interrupt */
+            elapsed += chunk - SYSTICK_CURRENT_REG;
+            break;
+        }
+    } while (remaining > 0);
+    elapsed += SYSTICK_TICKLESS_COMPENSATION_CYCLES;
+    elapsed_ticks = SysTick_CarryElapsed(tick_cycles, current, elapsed);
+
+    NVIC_ExitCritical(state);
+    return elapsed_ticks;
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_SaveContext
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): a_Context - CTRL, RELOAD and the cycles left in the tick
+ * Return value: None
+ * Description: Stops SysTick and captures its registers before a low power
+ *              mode. A tick already pending stays pending in ICSR.
+ *****************************************************************************/
+void SysTick_SaveContext(SysTick_ContextType *a_Context)
+{
+    NVIC_CriticalStateType state = NVIC_EnterCritical();
+    uint32 ctrl = SYSTICK_CTRL_REG;
+
+    SYSTICK_CTRL_REG = ctrl & ~SYSTICK_CTRL_ENABLE_MASK;
+    a_Context->Ctrl = ctrl & ~SYSTICK_CTRL_COUNTFLAG_MASK;
+    a_Context->Reload = SYSTICK_RELOAD_REG;
+    a_Context->Current = SYSTICK_CURRENT_REG;
+    if (a_Context->Current == 0) {
+        /* Stopped on the wrap, its tick is already pending and a full period is left */
+        a_Context->Current = a_Context->Reload + 1;
+    }
+
+    NVIC_ExitCritical(state);
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_RestoreContext
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): a_Context - State captured by SysTick_SaveContext
+ *                 a_SleptCycles - Core cycles spent with SysTick stopped, as
+ *                                 measured by a wake-up timer, 0 if unknown
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Number of ticks carried into the time base
+ * Description: Writes RELOAD and CTRL back and restarts the counter in phase,
+ *              carrying a_SleptCycles into the time base, software timers
+ *              and task table the same way SysTick_TicklessIdle does.
+ *****************************************************************************/
+uint32 SysTick_RestoreContext(const SysTick_ContextType *a_Context, uint64 a_SleptCycles)
+{
+    uint32 elapsed_ticks = 0;
+    NVIC_CriticalStateType state = NVIC_EnterCritical();
+
+    SYSTICK_CTRL_REG = a_Context->Ctrl & ~SYSTICK_CTRL_ENABLE_MASK;
+    if (a_Context->Ctrl & SYSTICK_CTRL_ENABLE_MASK) {
+        elapsed_ticks = SysTick_CarryElapsed(a_Context->Reload + 1, a_Context->Current, a_SleptCycles);
+    } else {
+        SYSTICK_RELOAD_REG = a_Context->Reload;
+    }
+
+    NVIC_ExitCritical(state);
+    return elapsed_ticks;
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_GetCycles
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint64 - Core cycles since the time base started
+ * Description: Monotonic 64-bit cycle timestamp. Combines the time base kept
+ *              by SysTick_Handler with SYSTICK_CURRENT_REG without masking
+ *              interrupts, a concurrent handler only causes a retry.
+ *****************************************************************************/
+uint64 SysTick_GetCycles(void)
+{
+    SysTick_TimeType time;
+    uint32 in_tick = SysTick_TimeRead(&time);
+    return time.Cycles + in_tick;
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_GetTicks
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint64 - SysTick periods since the time base started
+ * Description: Monotonic 64-bit tick count, including a wrap whose handler is
+ *              still pending.
+ *****************************************************************************/
+uint64 SysTick_GetTicks(void)
+{
+    SysTick_TimeType time;
+    uint32 in_tick = SysTick_TimeRead(&time);
+    return time.Ticks + ((in_tick > SYSTICK_RELOAD_REG) ? 1 : 0);
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_GetMicroseconds
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint64 - Microseconds since the time base started
+ * Description: Monotonic 64-bit microsecond timestamp. The handler keeps the
+ *              microsecond count up to date, so a read only needs a 32-bit
+ *              division by a constant.
+ *****************************************************************************/
+uint64 SysTick_GetMicroseconds(void)
+{
+    SysTick_TimeType time;
+    uint32 in_tick = SysTick_TimeRead(&time);
+    return time.Microseconds + ((time.Remainder_Cycles + in_tick) / SYSTICK_CYCLES_PER_US);
+}
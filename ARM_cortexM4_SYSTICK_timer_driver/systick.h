@@ -1,80 +1,177 @@
-/******************************************************************************
- *
- * Module: timer
- *
- * File Name: systick_timer.h
- *
- * Description: Header file for the ARM Cortex M4 timer driver
- *
- * Author: Ahmed Osama
- *
- *******************************************************************************/
-
-
-#ifndef SYSTICK_H_
-#define SYSTICK_H_
-
-
-
-/*******************************************************************************
- *                                Inclusions                                   *
- *******************************************************************************/
-#include"tm4c123gh6pm_registers.h"
-#include "std_types.h"
-/*******************************************************************************
- *                           Preprocessor Definitions                          *
- *******************************************************************************/
-#define tick_per_sec 15999999
-
-
-
-/* Enable Exceptions ... This Macro enable IRQ interrupts, Programmable Systems Exceptions and Faults by clearing the I-bit in the PRIMASK. */
-#define Enable_Exceptions()    __asm(" CPSIE I ")
-
-/* Disable Exceptions ... This Macro disable IRQ interrupts, Programmable Systems Exceptions and Faults by setting the I-bit in the PRIMASK. */
-#define Disable_Exceptions()   __asm(" CPSID I ")
-
-/* Enable Faults ... This Macro enable Faults by clearing the F-bit in the FAULTMASK */
-#define Enable_Faults()        __asm(" CPSIE F ")
-
-/* Disable Faults ... This Macro disable Faults by setting the F-bit in the FAULTMASK */
-#define Disable_Faults()       __asm(" CPSID F ")
-
-/* Go to low power mode while waiting for the next interrupt */
-#define Wait_For_Interrupt()   __asm(" WFI ")
-
-/*******************************************************************************
- *                           Data Types Declarations                           *
- *******************************************************************************/
-static  void (*SYSTICK_call_back)(void) = NULL_PTR;
-
-
-/*******************************************************************************
- *                            Functions Prototypes                             *
- *******************************************************************************/
-
-void SysTick_Init(uint16 a_TimeInMilliSeconds);
-
-void SysTick_Handler(void);
-
-void SysTick_SetCallBack(volatile void (*Ptr2Func) (void));
-
-void SysTick_Stop(void);
-
-void SysTick_Start(void);
-
-void SysTick_DeInit(void);
-
-void SysTick_StartBusyWait(uint16 a_TimeInMilliSeconds);
-
-
-
-/************************************************************************************
- *                                 End of File                                      *
- ************************************************************************************/
-
-
-
-
-
-#endif /* SYSTICK_H_ */
+/******************************************************************************
+ *
+ * Module: timer
+ *
+ * File Name: systick_timer.h
+ *
+ * Description: Header file for the ARM Cortex M4 timer driver
+ *
+ * Author: Ahmed Osama
+ *
+ *******************************************************************************/
+
+
+#ifndef SYSTICK_H_
+#define SYSTICK_H_
+
+
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include"tm4c123gh6pm_registers.h"
+#include "std_types.h"
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+/* Core clock feeding SysTick (CLK_SRC = system clock) */
+#ifndef SYSTICK_CORE_CLOCK_HZ
+#define SYSTICK_CORE_CLOCK_HZ                16000000
+#endif
+#define SYSTICK_CYCLES_PER_US                (SYSTICK_CORE_CLOCK_HZ / 1000000)
+
+#define tick_per_sec (SYSTICK_CORE_CLOCK_HZ - 1)
+
+/* SysTick CTRL register bits */
+#define SYSTICK_CTRL_ENABLE_MASK             0x00000001
+#define SYSTICK_CTRL_TICKINT_MASK            0x00000002
+#define SYSTICK_CTRL_CLK_SRC_MASK            0x00000004
+#define SYSTICK_CTRL_COUNTFLAG_MASK          0x00010000
+
+/* Largest value the 24-bit RELOAD register can hold */
+#define SYSTICK_MAX_RELOAD                   0x00FFFFFF
+
+/* Fixed cost of a delay call (entry, setup and exit) removed from every requested delay. It depends on the
+ * compiler, the optimization level and the flash wait states, so it is 0 (never shorten a delay) until measured
+ * on the target: start the DWT cycle counter (NVIC_ProfilerInit), read NVIC_DWT_CYCCNT_REG right before and
+ * right after SysTick_DelayCycles(1000) with this set to 0, and set it to the difference minus 1000. */
+#ifndef SYSTICK_DELAY_OVERHEAD_CYCLES
+#define SYSTICK_DELAY_OVERHEAD_CYCLES        0
+#endif
+
+/* Cycles the counter spends stopped while SysTick_TicklessIdle enters and leaves the sleep, added back to the
+ * time base. Like the delay overhead it depends on the build, so it is 0 until measured on the target: with the
+ * DWT cycle counter running (NVIC_ProfilerInit), compare the NVIC_DWT_CYCCNT_REG delta across a
+ * SysTick_TicklessIdle call with the SysTick_GetCycles() delta across it and set this to the shortfall. */
+#ifndef SYSTICK_TICKLESS_COMPENSATION_CYCLES
+#define SYSTICK_TICKLESS_COMPENSATION_CYCLES 0
+#endif
+
+/* Services run from SysTick_Handler on every tick, set to 0 to compile them out */
+#ifndef SYSTICK_TIMERS_ENABLED
+#define SYSTICK_TIMERS_ENABLED               1
+#endif
+
+#ifndef SYSTICK_SCHEDULE_ENABLED
+#define SYSTICK_SCHEDULE_ENABLED             0
+#endif
+
+#ifndef SYSTICK_STORM_ENABLED
+#define SYSTICK_STORM_ENABLED                0
+#endif
+
+#ifndef SYSTICK_COALESCE_ENABLED
+#define SYSTICK_COALESCE_ENABLED             0
+#endif
+
+#ifndef SYSTICK_KERNEL_ENABLED
+#define SYSTICK_KERNEL_ENABLED               0
+#endif
+
+
+
+/* Enable Exceptions ... This Macro enable IRQ interrupts, Programmable Systems Exceptions and Faults by clearing the I-bit in the PRIMASK. */
+#ifndef Enable_Exceptions
+#define Enable_Exceptions()    __asm(" CPSIE I ")
+#endif
+
+/* Disable Exceptions ... This Macro disable IRQ interrupts, Programmable Systems Exceptions and Faults by setting the I-bit in the PRIMASK. */
+#ifndef Disable_Exceptions
+#define Disable_Exceptions()   __asm(" CPSID I ")
+#endif
+
+/* Enable Faults ... This Macro enable Faults by clearing the F-bit in the FAULTMASK */
+#ifndef Enable_Faults
+#define Enable_Faults()        __asm(" CPSIE F ")
+#endif
+
+/* Disable Faults ... This Macro disable Faults by setting the F-bit in the FAULTMASK */
+#ifndef Disable_Faults
+#define Disable_Faults()       __asm(" CPSID F ")
+#endif
+
+/* Go to low power mode while waiting for the next interrupt */
+#ifndef Wait_For_Interrupt
+#define Wait_For_Interrupt()   __asm(" WFI ")
+#endif
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+static  void (*SYSTICK_call_back)(void) = NULL_PTR;
+
+/* Time base at the last tick boundary, published by SysTick_Handler */
+typedef struct
+{
+    uint64 Cycles;                  /* Core cycles since the time base started */
+    uint64 Ticks;                   /* SysTick periods since the time base started */
+    uint64 Microseconds;            /* Whole microseconds contained in Cycles */
+    uint32 Remainder_Cycles;        /* Cycles not yet counted in Microseconds */
+} SysTick_TimeType;
+
+/* SysTick state captured by SysTick_SaveContext */
+typedef struct
+{
+    uint32 Ctrl;                    /* CTRL without COUNTFLAG */
+    uint32 Reload;
+    uint32 Current;                 /* Cycles left until the next tick when the counter was stopped */
+} SysTick_ContextType;
+
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+void SysTick_Init(uint16 a_TimeInMilliSeconds);
+
+void SysTick_Handler(void);
+
+void SysTick_SetCallBack(volatile void (*Ptr2Func) (void));
+
+void SysTick_Stop(void);
+
+void SysTick_Start(void);
+
+void SysTick_DeInit(void);
+
+void SysTick_StartBusyWait(uint16 a_TimeInMilliSeconds);
+
+void SysTick_DelayCycles(uint32 a_Cycles);
+
+void SysTick_DelayMicroseconds(uint32 a_Microseconds);
+
+uint32 SysTick_IdleTicks(void);
+
+uint32 SysTick_TicklessIdle(uint32 a_IdleTicks);
+
+void SysTick_SaveContext(SysTick_ContextType *a_Context);
+
+uint32 SysTick_RestoreContext(const SysTick_ContextType *a_Context, uint64 a_SleptCycles);
+
+uint64 SysTick_GetCycles(void);
+
+uint64 SysTick_GetTicks(void);
+
+uint64 SysTick_GetMicroseconds(void);
+
+
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+
+
+
+
+#endif /* SYSTICK_H_ */
@@ -0,0 +1,346 @@
+/******************************************************************************
+ *
+ * Module: timer
+ *
+ * File Name: systick_schedule.c
+ *
+ * Description: Source file for the multi-rate periodic task table run by the SysTick timer
+ *
+ * Author: Ahmed Osama
+ *
+ ******************************************************************************/
+#include "systick_schedule.h"
+#include "systick.h"
+#include "nvic.h"
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef struct
+{
+    SysTick_ScheduleFunctionType Function;
+    void *Context;
+    uint16 Divider;
+    uint16 Phase;
+    uint32 Cost_Cycles;
+} SysTick_ScheduleEntryType;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+/* Number of tasks as a preprocessor value, the table and the per-task loops are compiled out when it is empty */
+#define SYSTICK_SCHEDULE_COUNT_ONE(NAME, FUNCTION, CONTEXT, DIVIDER, PHASE, COST)   + 1
+#define SYSTICK_SCHEDULE_ENTRIES             (0 SYSTICK_SCHEDULE_TABLE(SYSTICK_SCHEDULE_COUNT_ONE))
+
+/* Compile-time checks: a divider of 0 or a fixed phase outside its period gives a negative array size */
+#define SYSTICK_SCHEDULE_ENTRY_VALID(NAME, FUNCTION, CONTEXT, DIVIDER, PHASE, COST) \
+    && ((DIVIDER) > 0) && (((PHASE) == SYSTICK_SCHEDULE_AUTO_PHASE) || ((PHASE) < (DIVIDER)))
+typedef char SysTick_ScheduleTableCheck[(1 SYSTICK_SCHEDULE_TABLE(SYSTICK_SCHEDULE_ENTRY_VALID)) ? 1 : -1];
+
+/* Stats and phases keep one spare entry so the arrays are never empty */
+static uint16 SysTick_SchedulePhase[SYSTICK_SCHEDULE_TASK_COUNT + 1];
+static SysTick_ScheduleStatsType SysTick_ScheduleStats[SYSTICK_SCHEDULE_TASK_COUNT + 1];
+static uint32 SysTick_ScheduleTickOverruns;
+
+#if SYSTICK_SCHEDULE_ENTRIES > 0
+/* Task table generated from systick_schedule_cfg.h */
+#define SYSTICK_SCHEDULE_ENTRY(NAME, FUNCTION, CONTEXT, DIVIDER, PHASE, COST) \
+    { (FUNCTION), (void *)(CONTEXT), (DIVIDER), (PHASE), (COST) },
+static const SysTick_ScheduleEntryType SysTick_ScheduleTable[SYSTICK_SCHEDULE_TASK_COUNT] =
+{
+    SYSTICK_SCHEDULE_TABLE(SYSTICK_SCHEDULE_ENTRY)
+};
+
+static uint32 SysTick_ScheduleCountdown[SYSTICK_SCHEDULE_TASK_COUNT];   /* Ticks left before the next run */
+
+/* Expected cycles spent on each tick of the hyperperiod, only used by SysTick_ScheduleInit */
+static uint32 SysTick_ScheduleLoad[SYSTICK_SCHEDULE_MAX_HYPERPERIOD];
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+static uint32 SysTick_ScheduleGcd(uint32 a, uint32 b)
+{
+    while (b != 0) {
+        uint32 r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+/* Adds the cost of a task running at Phase to every tick it occupies in the hyperperiod */
+static void SysTick_ScheduleLoadAdd(uint32 Hyperperiod, uint32 Divider, uint32 Phase, uint32 Cost)
+{
+    uint32 tick;
+    for (tick = Phase % Hyperperiod; tick < Hyperperiod; tick += Divider) {
+        SysTick_ScheduleLoad[tick] += Cost;
+    }
+}
+
+/* Phase in [0, Divider) whose busiest tick carries the least load, ties go to the least total load */
+static uint16 SysTick_ScheduleBestPhase(uint32 Hyperperiod, uint32 Divider)
+{
+    uint32 phase;
+    uint32 tick;
+    uint32 peak;
+    uint32 sum;
+    uint32 best_peak = 0xFFFFFFFF;
+    uint32 best_sum = 0xFFFFFFFF;
+    uint16 best = 0;
+
+    for (phase = 0; (phase < Divider) && (phase < Hyperperiod); phase++) {
+        peak = 0;
+        sum = 0;
+        for (tick = phase; tick < Hyperperiod; tick += Divider) {
+            if (SysTick_ScheduleLoad[tick] > peak) {
+                peak = SysTick_ScheduleLoad[tick];
+            }
+            sum += SysTick_ScheduleLoad[tick];
+        }
+        if ((peak < best_peak) || ((peak == best_peak) && (sum < best_sum))) {
+            best_peak = peak;
+            best_sum = sum;
+            best = (uint16)phase;
+        }
+    }
+    return best;
+}
+#endif
+
+/*****************************************************************************
+ * Service Name: SysTick_ScheduleInit
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Places the fixed phase tasks on a load map of the hyperperiod,
+ *              then gives each automatic task, fastest rate first and the
+ *              heaviest first among equal rates, the phase that keeps the
+ *              busiest tick lightest. Call before SysTick_Init.
+ *****************************************************************************/
+void SysTick_ScheduleInit(void)
+{
+#if SYSTICK_SCHEDULE_ENTRIES > 0
+    uint32 hyperperiod = 1;
+    uint32 task;
+    uint32 next;
+    uint32 placed;
+    boolean done[SYSTICK_SCHEDULE_TASK_COUNT + 1];
+
+    for (task = 0; task < (uint32)SYSTICK_SCHEDULE_TASK_COUNT; task++) {
+        uint32 divider = SysTick_ScheduleTable[task].Divider;
+        hyperperiod = (hyperperiod / SysTick_ScheduleGcd(hyperperiod, divider)) * divider;
+        if (hyperperiod > SYSTICK_SCHEDULE_MAX_HYPERPERIOD) {
+            /* Folded, see SYSTICK_SCHEDULE_MAX_HYPERPERIOD: only the phase balancing becomes approximate */
+            hyperperiod = SYSTICK_SCHEDULE_MAX_HYPERPERIOD;
+        }
+    }
+    for (next = 0; next < hyperperiod; next++) {
+        SysTick_ScheduleLoad[next] = 0;
+    }
+
+    for (task = 0; task < (uint32)SYSTICK_SCHEDULE_TASK_COUNT; task++) {
+        const SysTick_ScheduleEntryType *entry = &SysTick_ScheduleTable[task];
+        done[task] = (entry->Phase != SYSTICK_SCHEDULE_AUTO_PHASE) ? TRUE : FALSE;
+        if (done[task] != FALSE) {
+            SysTick_SchedulePhase[task] = entry->Phase;
+            SysTick_ScheduleLoadAdd(hyperperiod, entry->Divider, entry->Phase, entry->Cost_Cycles + 1);
+        }
+    }
+
+    for (placed = 0; placed < (uint32)SYSTICK_SCHEDULE_TASK_COUNT; placed++) {
+        next = SYSTICK_SCHEDULE_TASK_COUNT;
+        for (task = 0; task < (uint32)SYSTICK_SCHEDULE_TASK_COUNT; task++) {
+            if ((done[task] == FALSE) &&
+                ((next == SYSTICK_SCHEDULE_TASK_COUNT) ||
+                 (SysTick_ScheduleTable[task].Divider < SysTick_ScheduleTable[next].Divider) ||
+                 ((SysTick_ScheduleTable[task].Divider == SysTick_ScheduleTable[next].Divider) &&
+                  (SysTick_ScheduleTable[task].Cost_Cycles > SysTick_ScheduleTable[next].Cost_Cycles)))) {
+                next = task;
+            }
+        }
+        if (next == SYSTICK_SCHEDULE_TASK_COUNT) {
+            break;
+        }
+        SysTick_SchedulePhase[next] = SysTick_ScheduleBestPhase(hyperperiod, SysTick_ScheduleTable[next].Divider);
+        SysTick_ScheduleLoadAdd(hyperperiod, SysTick_ScheduleTable[next].Divider, SysTick_SchedulePhase[next],
+                                SysTick_ScheduleTable[next].Cost_Cycles + 1);
+        done[next] = TRUE;
+    }
+
+    for (task = 0; task < (uint32)SYSTICK_SCHEDULE_TASK_COUNT; task++) {
+        SysTick_ScheduleCountdown[task] = SysTick_SchedulePhase[task];
+        SysTick_ScheduleStats[task].Runs = 0;
+        SysTick_ScheduleStats[task].Overruns = 0;
+        SysTick_ScheduleStats[task].Max_Run_Cycles = 0;
+        SysTick_ScheduleStats[task].Min_Start_Cycles = 0xFFFFFFFF;
+        SysTick_ScheduleStats[task].Max_Start_Cycles = 0;
+    }
+#endif
+    SysTick_ScheduleTickOverruns = 0;
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_ScheduleTick
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Runs every task whose countdown reached 0, in table order, and
+ *              updates its run time, start time and overrun counters.
+ *****************************************************************************/
+void SysTick_ScheduleTick(void)
+{
+#if SYSTICK_SCHEDULE_ENTRIES > 0
+    uint32 task;
+    uint32 start;
+    uint32 run;
+    uint64 dispatch = SysTick_GetCycles();
+    SysTick_ScheduleStatsType *stats;
+
+    for (task = 0; task < (uint32)SYSTICK_SCHEDULE_TASK_COUNT; task++) {
+        if (SysTick_ScheduleCountdown[task] != 0) {
+            SysTick_ScheduleCountdown[task]--;
+            continue;
+        }
+        SysTick_ScheduleCountdown[task] = SysTick_ScheduleTable[task].Divider - 1;
+
+        stats = &SysTick_ScheduleStats[task];
+        start = (uint32)(SysTick_GetCycles() - dispatch);
+        SysTick_ScheduleTable[task].Function(SysTick_ScheduleTable[task].Context);
+        run = (uint32)(SysTick_GetCycles() - dispatch) - start;
+
+        stats->Runs++;
+        if (run > stats->Max_Run_Cycles) {
+            stats->Max_Run_Cycles = run;
+        }
+        if (run > SysTick_ScheduleTable[task].Cost_Cycles) {
+            stats->Overruns++;
+        }
+        if (start < stats->Min_Start_Cycles) {
+            stats->Min_Start_Cycles = start;
+        }
+        if (start > stats->Max_Start_Cycles) {
+            stats->Max_Start_Cycles = start;
+        }
+    }
+#endif
+    if (NVIC_ICSR_REG & NVIC_ICSR_PENDSTSET_MASK) {
+        SysTick_ScheduleTickOverruns++;
+    }
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_ScheduleTicksToNext
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Ticks until the next tick that runs a task,
+ *               0xFFFFFFFF if the table is empty
+ * Description: Used together with SysTick_TimerTicksToNext to pick the
+ *              tickless idle length.
+ *****************************************************************************/
+uint32 SysTick_ScheduleTicksToNext(void)
+{
+    uint32 best = 0xFFFFFFFF;
+#if SYSTICK_SCHEDULE_ENTRIES > 0
+    uint32 task;
+    NVIC_CriticalStateType state = NVIC_EnterCritical();
+
+    for (task = 0; task < (uint32)SYSTICK_SCHEDULE_TASK_COUNT; task++) {
+        if (SysTick_ScheduleCountdown[task] < best - 1) {
+            best = SysTick_ScheduleCountdown[task] + 1;
+        }
+    }
+
+    NVIC_ExitCritical(state);
+#endif
+    return best;
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_ScheduleSkip
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): Ticks - Ticks slept through by the tickless idle
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Accounts for ticks that produced no interrupt. Ticks should
+ *              be lower than the value SysTick_ScheduleTicksToNext() returned,
+ *              a task whose run would have been skipped is left due and runs
+ *              once on the next tick instead.
+ *****************************************************************************/
+void SysTick_ScheduleSkip(uint32 Ticks)
+{
+#if SYSTICK_SCHEDULE_ENTRIES > 0
+    uint32 task;
+
+    for (task = 0; task < (uint32)SYSTICK_SCHEDULE_TASK_COUNT; task++) {
+        if (Ticks < SysTick_ScheduleCountdown[task]) {
+            SysTick_ScheduleCountdown[task] -= Ticks;
+        } else {
+            SysTick_ScheduleCountdown[task] = 0;
+        }
+    }
+#else
+    (void)Ticks;
+#endif
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_ScheduleGetPhase
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Task - Task identifier
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint16 - Tick offset of the task inside its period
+ * Description: Reads back the phase chosen by SysTick_ScheduleInit.
+ *****************************************************************************/
+uint16 SysTick_ScheduleGetPhase(SysTick_ScheduleTaskType Task)
+{
+    return SysTick_SchedulePhase[Task];
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_ScheduleGetStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Task - Task identifier
+ * Parameters (inout): None
+ * Parameters (out): Stats - Copy of the task counters
+ * Return value: None
+ * Description: Copies the counters of a task with exceptions masked so the
+ *              copy is never torn by SysTick_Handler.
+ *****************************************************************************/
+void SysTick_ScheduleGetStats(SysTick_ScheduleTaskType Task, SysTick_ScheduleStatsType *Stats)
+{
+    NVIC_CriticalStateType state = NVIC_EnterCritical();
+    *Stats = SysTick_ScheduleStats[Task];
+    NVIC_ExitCritical(state);
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_ScheduleGetTickOverruns
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Ticks whose task dispatch outlasted the tick period
+ * Description: A non-zero value means the table does not fit the tick.
+ *****************************************************************************/
+uint32 SysTick_ScheduleGetTickOverruns(void)
+{
+    return SysTick_ScheduleTickOverruns;
+}
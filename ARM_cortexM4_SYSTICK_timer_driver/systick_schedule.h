@@ -0,0 +1,90 @@
+/******************************************************************************
+ *
+ * Module: timer
+ *
+ * File Name: systick_schedule.h
+ *
+ * Description: Header file for the multi-rate periodic task table run by the SysTick timer
+ *
+ * Author: Ahmed Osama
+ *
+ *******************************************************************************/
+
+#ifndef SYSTICK_SCHEDULE_H_
+#define SYSTICK_SCHEDULE_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+#include "systick_schedule_cfg.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Phase value asking SysTick_ScheduleInit to choose the phase of a task */
+#define SYSTICK_SCHEDULE_AUTO_PHASE          0xFFFF
+
+/* Longest hyperperiod (LCM of the rate dividers) the phase assignment models exactly. Costs 4 bytes of RAM
+ * per tick. A longer hyperperiod is folded into this many ticks: every task still runs at its own rate and
+ * phase, but the load map SysTick_ScheduleInit balances wraps at the fold, so the automatic phases may no
+ * longer give the flattest per-tick load. Raise it to the LCM of the table when the balancing matters. */
+#ifndef SYSTICK_SCHEDULE_MAX_HYPERPERIOD
+#define SYSTICK_SCHEDULE_MAX_HYPERPERIOD     200
+#endif
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef void (*SysTick_ScheduleFunctionType)(void *Context);
+
+/* Task identifiers, SYSTICK_SCHEDULE_TASK_<Name> in table order */
+#define SYSTICK_SCHEDULE_TASK_ID(NAME, FUNCTION, CONTEXT, DIVIDER, PHASE, COST)    SYSTICK_SCHEDULE_TASK_##NAME,
+typedef enum
+{
+    SYSTICK_SCHEDULE_TABLE(SYSTICK_SCHEDULE_TASK_ID)
+    SYSTICK_SCHEDULE_TASK_COUNT
+} SysTick_ScheduleTaskType;
+#undef SYSTICK_SCHEDULE_TASK_ID
+
+/* Per-task counters, start times are cycles after the tick's dispatch began, from SysTick_GetCycles() */
+typedef struct
+{
+    uint32 Runs;
+    uint32 Overruns;                    /* Runs longer than Cost_Cycles */
+    uint32 Max_Run_Cycles;
+    uint32 Min_Start_Cycles;
+    uint32 Max_Start_Cycles;            /* Jitter = Max_Start_Cycles - Min_Start_Cycles */
+} SysTick_ScheduleStatsType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+// Assigns the automatic phases, clears the counters and restarts every task at tick 0 of its period
+void SysTick_ScheduleInit(void);
+
+// Runs the tasks due on this tick, called from SysTick_Handler
+void SysTick_ScheduleTick(void);
+
+// Returns the number of ticks until the next tick that runs a task
+uint32 SysTick_ScheduleTicksToNext(void);
+
+// Moves every task forward by Ticks without running them, Ticks must be below SysTick_ScheduleTicksToNext()
+void SysTick_ScheduleSkip(uint32 Ticks);
+
+// Returns the phase a task runs at, after automatic assignment
+uint16 SysTick_ScheduleGetPhase(SysTick_ScheduleTaskType Task);
+
+// Copies the counters of a task
+void SysTick_ScheduleGetStats(SysTick_ScheduleTaskType Task, SysTick_ScheduleStatsType *Stats);
+
+// Returns the number of ticks whose dispatch ran into the next tick
+uint32 SysTick_ScheduleGetTickOverruns(void);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* SYSTICK_SCHEDULE_H_ */
@@ -0,0 +1,42 @@
+/******************************************************************************
+ *
+ * Module: timer
+ *
+ * File Name: systick_schedule_cfg.h
+ *
+ * Description: Static multi-rate task table dispatched from the SysTick handler
+ *
+ * Author: Ahmed Osama
+ *
+ *******************************************************************************/
+
+#ifndef SYSTICK_SCHEDULE_CFG_H_
+#define SYSTICK_SCHEDULE_CFG_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+
+/* Headers declaring the task functions listed below */
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Task table, one ENTRY(Name, Function, Context, Rate_Divider, Phase, Cost_Cycles) per task.
+ *   Function     void Function(void *Context), run every Rate_Divider ticks
+ *   Phase        Tick offset inside the period, SYSTICK_SCHEDULE_AUTO_PHASE lets
+ *                SysTick_ScheduleInit pick the one that flattens the per-tick load
+ *   Cost_Cycles  Expected run time, weights the phase choice and is the overrun budget
+ * Example:
+ *     ENTRY(CURRENT_LOOP, CurrentLoop_Run, NULL_PTR,     1, 0,                           800)  \
+ *     ENTRY(SPEED_LOOP,   SpeedLoop_Run,   &Speed_Pid,   5, SYSTICK_SCHEDULE_AUTO_PHASE, 2000) \
+ *     ENTRY(TEMP_LOOP,    TempLoop_Run,    NULL_PTR,   100, SYSTICK_SCHEDULE_AUTO_PHASE, 6000) \
+ */
+#define SYSTICK_SCHEDULE_TABLE(ENTRY)
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* SYSTICK_SCHEDULE_CFG_H_ */
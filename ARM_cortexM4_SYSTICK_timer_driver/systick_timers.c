@@ -0,0 +1,322 @@
+/******************************************************************************
+ *
+ * Module: timer
+ *
+ * File Name: systick_timers.c
+ *
+ * Description: Source file for the software timers driven by the SysTick timer
+ *
+ * Author: Ahmed Osama
+ *
+ ******************************************************************************/
+
+#include "systick_timers.h"
+#include "nvic.h"
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static SysTick_TimerType *SysTick_TimerWheel[SYSTICK_TIMER_LEVELS][SYSTICK_TIMER_SLOTS];
+static volatile uint32 SysTick_TimerNow = 0;
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+/* The wheel is only touched at or below the SysTick priority, so it is guarded by a BASEPRI ceiling at that
+ * priority and the IRQs above it keep running through a cascade. BASEPRI cannot express Priority_0, a SysTick
+ * left at its reset priority is guarded with PRIMASK instead. */
+static uint32 SysTick_TimerCeiling(void)
+{
+    return (NVIC_SYSTEM_PRI3_REG & SYSTICK_PRIORITY_MASK) >> SYSTICK_PRIORITY_BITS_POS;
+}
+
+static NVIC_CriticalStateType SysTick_TimerLock(uint32 Ceiling)
+{
+    return (Ceiling == Priority_0) ? NVIC_EnterCritical() : NVIC_EnterCriticalCeiling((NVIC_IRQPriorityType)Ceiling);
+}
+
+static void SysTick_TimerUnlock(uint32 Ceiling, NVIC_CriticalStateType Saved_State)
+{
+    if (Ceiling == Priority_0) {
+        NVIC_ExitCritical(Saved_State);
+    } else {
+        NVIC_ExitCriticalCeiling(Saved_State);
+    }
+}
+
+/* Links a timer into the head of a list */
+static void SysTick_TimerLink(SysTick_TimerType **List, SysTick_TimerType *Timer)
+{
+    Timer->Next = *List;
+    if (*List != NULL_PTR) {
+        (*List)->Prev_Link = &Timer->Next;
+    }
+    Timer->Prev_Link = List;
+    *List = Timer;
+}
+
+/* Removes a timer from whatever list holds it */
+static void SysTick_TimerUnlink(SysTick_TimerType *Timer)
+{
+    *Timer->Prev_Link = Timer->Next;
+    if (Timer->Next != NULL_PTR) {
+        Timer->Next->Prev_Link = Timer->Prev_Link;
+    }
+    Timer->Prev_Link = NULL_PTR;
+}
+
+/* Places a timer in the lowest level whose range covers its remaining delay */
+static void SysTick_TimerInsert(SysTick_TimerType *Timer)
+{
+    uint32 delta = Timer->Expires - SysTick_TimerNow;
+    uint32 slot_tick = Timer->Expires;
+    uint8 level = 0;
+
+    if (delta >= SYSTICK_TIMER_MAX_DELTA) {
+        /* Park it in the farthest slot, it is re-inserted with its real expiry when cascaded */
+        delta = SYSTICK_TIMER_MAX_DELTA - 1;
+        slot_tick = SysTick_TimerNow + delta;
+    }
+    while ((delta >> (SYSTICK_TIMER_SLOT_BITS * (level + 1))) != 0) {
+        level++;
+    }
+    SysTick_TimerLink(&SysTick_TimerWheel[level][(slot_tick >> (SYSTICK_TIMER_SLOT_BITS * level)) & SYSTICK_TIMER_SLOT_MASK],
+                      Timer);
+}
+
+/* Moves every timer of an upper level slot down to the level matching its remaining delay */
+static void SysTick_TimerCascade(uint8 Level, uint32 Index)
+{
+    SysTick_TimerType *timer = SysTick_TimerWheel[Level][Index];
+    SysTick_TimerType *next;
+
+    SysTick_TimerWheel[Level][Index] = NULL_PTR;
+    while (timer != NULL_PTR) {
+        next = timer->Next;
+        SysTick_TimerInsert(timer);
+        timer = next;
+    }
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_TimerInit
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Empties every slot of the timing wheel. Timers that were armed
+ *              are forgotten and must be set up again.
+ *****************************************************************************/
+void SysTick_TimerInit(void)
+{
+    uint8 level;
+    uint8 slot;
+
+    for (level = 0; level < SYSTICK_TIMER_LEVELS; level++) {
+        for (slot = 0; slot < SYSTICK_TIMER_SLOTS; slot++) {
+            SysTick_TimerWheel[level][slot] = NULL_PTR;
+        }
+    }
+    SysTick_TimerNow = 0;
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_TimerSetup
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): CallBack - Function called from SysTick_Handler on expiry
+ *                 Context - Argument passed to CallBack
+ * Parameters (inout): None
+ * Parameters (out): Timer - Timer node to initialize
+ * Return value: None
+ * Description: Initializes a disarmed timer node.
+ *****************************************************************************/
+void SysTick_TimerSetup(SysTick_TimerType *Timer, SysTick_TimerCallBackType CallBack, void *Context)
+{
+    Timer->Next = NULL_PTR;
+    Timer->Prev_Link = NULL_PTR;
+    Timer->Expires = 0;
+    Timer->Period = 0;
+    Timer->CallBack = CallBack;
+    Timer->Context = Context;
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_TimerStart
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Delay_Ticks - Ticks until the first expiry, 0 is treated as 1
+ *                 Period_Ticks - Ticks between later expiries, 0 for one-shot
+ * Parameters (inout): Timer - Timer node set up with SysTick_TimerSetup
+ * Parameters (out): None
+ * Return value: None
+ * Description: Arms (or re-arms) a timer in O(1), no memory is allocated.
+ *****************************************************************************/
+void SysTick_TimerStart(SysTick_TimerType *Timer, uint32 Delay_Ticks, uint32 Period_Ticks)
+{
+    uint32 ceiling = SysTick_TimerCeiling();
+    NVIC_CriticalStateType state = SysTick_TimerLock(ceiling);
+
+    if (Timer->Prev_Link != NULL_PTR) {
+        SysTick_TimerUnlink(Timer);
+    }
+    Timer->Expires = SysTick_TimerNow + ((Delay_Ticks == 0) ? 1 : Delay_Ticks);
+    Timer->Period = Period_Ticks;
+    SysTick_TimerInsert(Timer);
+
+    SysTick_TimerUnlock(ceiling, state);
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_TimerStop
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): Timer - Timer node to disarm
+ * Parameters (out): None
+ * Return value: None
+ * Description: Disarms a timer in O(1). Safe to call from an expiry callback,
+ *              including on the timer that is expiring.
+ *****************************************************************************/
+void SysTick_TimerStop(SysTick_TimerType *Timer)
+{
+    uint32 ceiling = SysTick_TimerCeiling();
+    NVIC_CriticalStateType state = SysTick_TimerLock(ceiling);
+
+    if (Timer->Prev_Link != NULL_PTR) {
+        SysTick_TimerUnlink(Timer);
+    }
+    Timer->Period = 0;
+
+    SysTick_TimerUnlock(ceiling, state);
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_TimerIsActive
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Timer - Timer node
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the timer is armed
+ * Description: Checks whether a timer is waiting in the wheel.
+ *****************************************************************************/
+boolean SysTick_TimerIsActive(const SysTick_TimerType *Timer)
+{
+    return (Timer->Prev_Link != NULL_PTR) ? TRUE : FALSE;
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_TimerTick
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Advances the wheel by one tick. Upper levels are cascaded only
+ *              when the lower level wraps and only the current level 0 slot
+ *              is visited, so the cost does not depend on how many timers
+ *              are armed. Periodic timers are re-armed from their previous
+ *              expiry so they do not drift. The cascade runs under a BASEPRI
+ *              ceiling at the SysTick priority, so it only delays IRQs that
+ *              could not preempt SysTick anyway. Callbacks run unmasked.
+ *****************************************************************************/
+void SysTick_TimerTick(void)
+{
+    SysTick_TimerType *expired;
+    SysTick_TimerType *timer;
+    uint8 level;
+    uint32 now = SysTick_TimerNow + 1;
+    uint32 ceiling = SysTick_TimerCeiling();
+    NVIC_CriticalStateType state = SysTick_TimerLock(ceiling);
+
+    SysTick_TimerNow = now;
+    for (level = 1; level < SYSTICK_TIMER_LEVELS; level++) {
+        if (((now >> (SYSTICK_TIMER_SLOT_BITS * (level - 1))) & SYSTICK_TIMER_SLOT_MASK) != 0) {
+            break;
+        }
+        SysTick_TimerCascade(level, (now >> (SYSTICK_TIMER_SLOT_BITS * level)) & SYSTICK_TIMER_SLOT_MASK);
+    }
+
+    /* Detach the due slot so callbacks may stop or re-arm any timer while it is drained */
+    expired = SysTick_TimerWheel[0][now & SYSTICK_TIMER_SLOT_MASK];
+    SysTick_TimerWheel[0][now & SYSTICK_TIMER_SLOT_MASK] = NULL_PTR;
+    if (expired != NULL_PTR) {
+        expired->Prev_Link = &expired;
+    }
+    while (expired != NULL_PTR) {
+        timer = expired;
+        SysTick_TimerUnlink(timer);
+        if (timer->Period != 0) {
+            timer->Expires += timer->Period;
+            SysTick_TimerInsert(timer);
+        }
+        SysTick_TimerUnlock(ceiling, state);
+        timer->CallBack(timer->Context);
+        state = SysTick_TimerLock(ceiling);
+    }
+
+    SysTick_TimerUnlock(ceiling, state);
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_TimerTicksToNext
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Ticks until the next tick that expires or cascades timers
+ * Description: Finds the first non-empty slot ahead of the current position on
+ *              each level. Used by the tickless idle to pick its sleep length.
+ *****************************************************************************/
+uint32 SysTick_TimerTicksToNext(void)
+{
+    uint32 best = SYSTICK_TIMER_MAX_DELTA;
+    uint32 now;
+    uint32 rounds;
+    uint32 ticks;
+    uint8 shift;
+    uint8 level;
+    uint32 ceiling = SysTick_TimerCeiling();
+    NVIC_CriticalStateType state = SysTick_TimerLock(ceiling);
+
+    now = SysTick_TimerNow;
+    for (level = 0; level < SYSTICK_TIMER_LEVELS; level++) {
+        shift = SYSTICK_TIMER_SLOT_BITS * level;
+        for (rounds = 1; rounds <= SYSTICK_TIMER_SLOTS; rounds++) {
+            if (SysTick_TimerWheel[level][((now >> shift) + rounds) & SYSTICK_TIMER_SLOT_MASK] != NULL_PTR) {
+                /* The slot is visited when the tick count reaches its aligned start */
+                ticks = ((((now >> shift) + rounds) << shift) - now);
+                if (ticks < best) {
+                    best = ticks;
+                }
+                break;
+            }
+        }
+    }
+
+    SysTick_TimerUnlock(ceiling, state);
+    return best;
+}
+
+/*****************************************************************************
+ * Service Name: SysTick_TimerSkip
+ * Sync/Async: Synchronous
+ * Reentrancy: Non-reentrant
+ * Parameters (in): Ticks - Number of ticks to move forward
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Accounts for ticks slept through in tickless idle. Only valid
+ *              for ticks that have no work, i.e. fewer than
+ *              SysTick_TimerTicksToNext() returned before sleeping.
+ *****************************************************************************/
+void SysTick_TimerSkip(uint32 Ticks)
+{
+    SysTick_TimerNow += Ticks;
+}
@@ -0,0 +1,84 @@
+/******************************************************************************
+ *
+ * Module: timer
+ *
+ * File Name: systick_timers.h
+ *
+ * Description: Header file for the software timers driven by the SysTick timer
+ *
+ * Author: Ahmed Osama
+ *
+ *******************************************************************************/
+
+#ifndef SYSTICK_TIMERS_H_
+#define SYSTICK_TIMERS_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Hierarchical timing wheel geometry: LEVELS wheels of 2^SLOT_BITS slots each.
+ * Delays up to 2^(SLOT_BITS * LEVELS) ticks are placed directly, longer ones are re-cascaded. */
+#define SYSTICK_TIMER_SLOT_BITS              6
+#define SYSTICK_TIMER_LEVELS                 4
+#define SYSTICK_TIMER_SLOTS                  (1 << SYSTICK_TIMER_SLOT_BITS)
+#define SYSTICK_TIMER_SLOT_MASK              (SYSTICK_TIMER_SLOTS - 1)
+#define SYSTICK_TIMER_MAX_DELTA              ((uint32)1 << (SYSTICK_TIMER_SLOT_BITS * SYSTICK_TIMER_LEVELS))
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+typedef void (*SysTick_TimerCallBackType)(void *Context);
+
+/* Caller-owned timer node, the fields are private to the timer module */
+typedef struct SysTick_Timer
+{
+    struct SysTick_Timer *Next;
+    struct SysTick_Timer **Prev_Link;      /* Address of the pointer that points at this node */
+    uint32 Expires;                        /* Absolute expiry tick */
+    uint32 Period;                         /* Reload in ticks, 0 for a one-shot timer */
+    SysTick_TimerCallBackType CallBack;
+    void *Context;
+} SysTick_TimerType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/* The timer services may be called from any context at or below the SysTick priority, the wheel is
+ * locked with a BASEPRI ceiling at that priority (PRIMASK while SysTick is at Priority_0). */
+
+// Empties the timing wheel and resets the tick counter
+void SysTick_TimerInit(void);
+
+// Attaches the expiry callback and its context to a timer node
+void SysTick_TimerSetup(SysTick_TimerType *Timer, SysTick_TimerCallBackType CallBack, void *Context);
+
+// Arms a timer to expire after Delay_Ticks, then every Period_Ticks if Period_Ticks is not 0
+void SysTick_TimerStart(SysTick_TimerType *Timer, uint32 Delay_Ticks, uint32 Period_Ticks);
+
+// Disarms a timer, does nothing if it is not armed
+void SysTick_TimerStop(SysTick_TimerType *Timer);
+
+// Returns TRUE if a timer is armed
+boolean SysTick_TimerIsActive(const SysTick_TimerType *Timer);
+
+// Advances the wheel by one tick and runs the expired timers, called from SysTick_Handler
+void SysTick_TimerTick(void);
+
+// Returns the number of ticks until the wheel next has work (an expiry or a cascade), at most SYSTICK_TIMER_MAX_DELTA
+uint32 SysTick_TimerTicksToNext(void);
+
+// Moves the wheel forward by Ticks without processing them, Ticks must be below SysTick_TimerTicksToNext()
+void SysTick_TimerSkip(uint32 Ticks);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* SYSTICK_TIMERS_H_ */
@@ -0,0 +1,479 @@
+/******************************************************************************
+ *
+ * Module: Host
+ *
+ * File Name: bench.c
+ *
+ * Description: Benchmark of every public function of nvic.h and systick.h on
+ *              the host build. Reports the register reads and writes of one
+ *              call, the host code size of the function and the host
+ *              nanoseconds per call, and writes the same report to a results
+ *              file. With --check <baseline> it fails when a function makes
+ *              more register reads or writes than the baseline allows; the
+ *              access counts are exact and host independent, the sizes and
+ *              times are not and are only reported.
+ *              Reads and writes are only counted when linked with the traced
+ *              drivers and tests/host_trace.c. The tracing hooks dominate the
+ *              time of such a build, so it takes the times from the results
+ *              of a run on the untraced drivers (--times), where every read
+ *              and write count is 0.
+ *
+ * Author: Ahmed Osama
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "nvic.h"
+#include "nvic_queue.h"
+#include "systick.h"
+#include "systick_timers.h"
+#include "systick_schedule.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define BENCH_ITERATIONS                     100000
+#define BENCH_NAME_LENGTH                    48
+#define BENCH_IRQ                            UART0_RXTX
+
+/* 1 ms tick at 16 MHz */
+#define BENCH_RELOAD                         15999
+
+/* Cycles the host SysTick counter moves on every CURRENT read during the delays */
+#define BENCH_DELAY_STEP                     100
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+static NVIC_IRQSetType Bench_Set;
+static NVIC_IRQSetType Bench_SetB;
+static NVIC_IRQSetType Bench_Result;
+static const NVIC_IRQType Bench_List[] = { UART0_RXTX, TIMER_0_SUBTIMER_A, PWM_1_FAULT };
+static NVIC_EventType Bench_Events[16];
+static NVIC_SPSCQueueType Bench_Spsc;
+static NVIC_MPSCCellType Bench_Cells[16];
+static NVIC_MPSCQueueType Bench_Mpsc;
+static SysTick_TimerType Bench_Timers[8];
+static NVIC_ContextType Bench_NvicContext;
+static SysTick_ContextType Bench_SysTickContext;
+static NVIC_HandlerType Bench_VectorTable[NVIC_VECTOR_COUNT];
+static NVIC_CriticalStateType Bench_State;
+static uint8 Bench_Preempt;
+static uint8 Bench_Sub;
+
+/*******************************************************************************
+ *                              Benchmarked Calls                              *
+ *******************************************************************************/
+
+static void Bench_Noop(void *Context)
+{
+    (void)Context;
+}
+
+static void Bench_Vector(void)
+{
+}
+
+/* The interrupt that ends a sleep: the SysTick chunk ran out */
+static void Bench_WakeOnWrap(void)
+{
+    Host_SysTick_Ctrl |= SYSTICK_CTRL_COUNTFLAG_MASK;
+    Host_SysTick_Current = 0;
+}
+
+/* The interrupt that ends a sleep-on-exit loop */
+static void Bench_WakeForThreadWork(void)
+{
+    NVIC_RequestThreadWork();
+}
+
+static void Bench_EnableIRQ(void)        { NVIC_EnableIRQ(BENCH_IRQ); }
+static void Bench_DisableIRQ(void)       { NVIC_DisableIRQ(BENCH_IRQ); }
+static void Bench_SetPriorityIRQ(void)   { NVIC_SetPriorityIRQ(BENCH_IRQ, Priority_5); }
+static void Bench_GetPriorityIRQ(void)   { (void)NVIC_GetPriorityIRQ(BENCH_IRQ); }
+static void Bench_SetPending(void)       { NVIC_SetPending(BENCH_IRQ); }
+static void Bench_ClearPending(void)     { NVIC_ClearPending(BENCH_IRQ); }
+static void Bench_IsPending(void)        { (void)NVIC_IsPending(BENCH_IRQ); }
+static void Bench_IsActive(void)         { (void)NVIC_IsActive(BENCH_IRQ); }
+static void Bench_TriggerIRQ(void)       { NVIC_TriggerIRQ(BENCH_IRQ); }
+static void Bench_IRQSetClear(void)      { NVIC_IRQSetClear(&Bench_Result); }
+static void Bench_IRQSetAdd(void)        { NVIC_IRQSetAdd(&Bench_Result, BENCH_IRQ); }
+static void Bench_IRQSetRemove(void)     { NVIC_IRQSetRemove(&Bench_Result, BENCH_IRQ); }
+static void Bench_IRQSetFromList(void)   { NVIC_IRQSetFromList(&Bench_Result, Bench_List, 3); }
+static void Bench_IRQSetUnion(void)      { NVIC_IRQSetUnion(&Bench_Result, &Bench_Set, &Bench_SetB); }
+static void Bench_IRQSetDifference(void) { NVIC_IRQSetDifference(&Bench_Result, &Bench_Set, &Bench_SetB); }
+static void Bench_EnableIRQSet(void)     { NVIC_EnableIRQSet(&Bench_Set); }
+static void Bench_DisableIRQSet(void)    { NVIC_DisableIRQSet(&Bench_Set); }
+static void Bench_SetPendingIRQSet(void) { NVIC_SetPendingIRQSet(&Bench_Set); }
+static void Bench_ApplyConfig(void)      { NVIC_ApplyConfig(); }
+static void Bench_NvicSave(void)         { NVIC_SaveContext(&Bench_NvicContext); }
+static void Bench_NvicRestore(void)      { NVIC_RestoreContext(&Bench_NvicContext); }
+static void Bench_SetGrouping(void)      { NVIC_SetPriorityGrouping(PRIGROUP_5); }
+static void Bench_GetGrouping(void)      { (void)NVIC_GetPriorityGrouping(); }
+static void Bench_Encode(void)           { NVIC_IRQPriorityType p; (void)NVIC_EncodePriority(1, 0, &p); }
+static void Bench_Decode(void)           { NVIC_DecodePriority(Priority_5, &Bench_Preempt, &Bench_Sub); }
+static void Bench_SetGroupedIRQ(void)    { (void)NVIC_SetGroupedPriorityIRQ(BENCH_IRQ, 1, 0); }
+static void Bench_GetGroupedIRQ(void)    { NVIC_GetGroupedPriorityIRQ(BENCH_IRQ, &Bench_Preempt, &Bench_Sub); }
+static void Bench_SetGroupedExc(void)    { (void)NVIC_SetGroupedPriorityException(EXCEPTION_PEND_SV_TYPE, 1, 0); }
+static void Bench_GetGroupedExc(void)    { (void)NVIC_GetGroupedPriorityException(EXCEPTION_PEND_SV_TYPE, &Bench_Preempt, &Bench_Sub); }
+static void Bench_Relocate(void)         { NVIC_RelocateVectorTable(); }
+static void Bench_RegisterHandler(void)  { NVIC_RegisterHandler(BENCH_IRQ, Bench_Vector); }
+static void Bench_RegisterExcHandler(void) { NVIC_RegisterExceptionHandler(EXCEPTION_PEND_SV_TYPE, Bench_Vector); }
+static void Bench_EnterCritical(void)    { Bench_State = NVIC_EnterCritical(); }
+static void Bench_ExitCritical(void)     { NVIC_ExitCritical(Bench_State); }
+static void Bench_EnterCeiling(void)     { Bench_State = NVIC_EnterCriticalCeiling(Priority_3); }
+static void Bench_ExitCeiling(void)      { NVIC_ExitCriticalCeiling(Bench_State); }
+static void Bench_ConfigureSleep(void)   { NVIC_ConfigureSleep(FALSE, TRUE); }
+static void Bench_RequestThreadWork(void) { NVIC_RequestThreadWork(); }
+static void Bench_EnableException(void)  { NVIC_EnableException(EXCEPTION_USAGE_FAULT_TYPE); }
+static void Bench_DisableException(void) { NVIC_DisableException(EXCEPTION_USAGE_FAULT_TYPE); }
+static void Bench_SetPriorityExc(void)   { NVIC_SetPriorityException(EXCEPTION_PEND_SV_TYPE, Priority_exception_7); }
+
+static void Bench_SleepOnExit(void)
+{
+    Host_Wfi_Hook = Bench_WakeForThreadWork;
+    NVIC_SleepOnExit();
+}
+
+static void Bench_SysTickInit(void)      { SysTick_Init(1); }
+static void Bench_Handler(void)          { SysTick_Handler(); }
+static void Bench_SetCallBack(void)      { SysTick_SetCallBack(NULL_PTR); }
+static void Bench_Stop(void)             { SysTick_Stop(); }
+static void Bench_Start(void)            { SysTick_Start(); }
+static void Bench_DeInit(void)           { SysTick_DeInit(); }
+static void Bench_IdleTicks(void)        { (void)SysTick_IdleTicks(); }
+static void Bench_SysTickSave(void)      { SysTick_SaveContext(&Bench_SysTickContext); }
+static void Bench_SysTickRestore(void)   { (void)SysTick_RestoreContext(&Bench_SysTickContext, 3 * 16000); }
+static void Bench_GetCycles(void)        { (void)SysTick_GetCycles(); }
+static void Bench_GetTicks(void)         { (void)SysTick_GetTicks(); }
+static void Bench_GetMicroseconds(void)  { (void)SysTick_GetMicroseconds(); }
+
+/* Delays poll CURRENT, the host counter moves BENCH_DELAY_STEP cycles per read while they run */
+static void Bench_BusyWait(void)
+{
+    Host_SysTick_Step = BENCH_DELAY_STEP * 10;
+    SysTick_StartBusyWait(1);
+    Host_SysTick_Step = 0;
+}
+
+static void Bench_DelayCycles(void)
+{
+    Host_SysTick_Step = BENCH_DELAY_STEP;
+    SysTick_DelayCycles(1000);
+    Host_SysTick_Step = 0;
+}
+
+static void Bench_DelayMicroseconds(void)
+{
+    Host_SysTick_Step = BENCH_DELAY_STEP;
+    SysTick_DelayMicroseconds(50);
+    Host_SysTick_Step = 0;
+}
+
+/* Sleeps through four ticks in one chunk, the counter is put back halfway through a period */
+static void Bench_TicklessIdle(void)
+{
+    Host_Wfi_Hook = Bench_WakeOnWrap;
+    Host_SysTick_Current = 8000;
+    Host_Scb_Icsr = 0;
+    (void)SysTick_TicklessIdle(4);
+}
+
+static void Bench_SPSCPushPop(void)
+{
+    NVIC_EventType event;
+    (void)NVIC_SPSCQueuePush(&Bench_Spsc, 1);
+    (void)NVIC_SPSCQueuePop(&Bench_Spsc, &event);
+}
+
+static void Bench_MPSCPushPop(void)
+{
+    NVIC_EventType event;
+    (void)NVIC_MPSCQueuePush(&Bench_Mpsc, 1);
+    (void)NVIC_MPSCQueuePop(&Bench_Mpsc, &event);
+}
+
+typedef struct
+{
+    const char *Name;
+    void (*Call)(void);
+} Bench_EntryType;
+
+static const Bench_EntryType Bench_Entries[] =
+{
+    { "NVIC_EnableIRQ",                   Bench_EnableIRQ },
+    { "NVIC_DisableIRQ",                  Bench_DisableIRQ },
+    { "NVIC_SetPriorityIRQ",              Bench_SetPriorityIRQ },
+    { "NVIC_GetPriorityIRQ",              Bench_GetPriorityIRQ },
+    { "NVIC_SetPending",                  Bench_SetPending },
+    { "NVIC_ClearPending",                Bench_ClearPending },
+    { "NVIC_IsPending",                   Bench_IsPending },
+    { "NVIC_IsActive",                    Bench_IsActive },
+    { "NVIC_TriggerIRQ",                  Bench_TriggerIRQ },
+    { "NVIC_IRQSetClear",                 Bench_IRQSetClear },
+    { "NVIC_IRQSetAdd",                   Bench_IRQSetAdd },
+    { "NVIC_IRQSetRemove",                Bench_IRQSetRemove },
+    { "NVIC_IRQSetFromList",              Bench_IRQSetFromList },
+    { "NVIC_IRQSetUnion",                 Bench_IRQSetUnion },
+    { "NVIC_IRQSetDifference",            Bench_IRQSetDifference },
+    { "NVIC_EnableIRQSet",                Bench_EnableIRQSet },
+    { "NVIC_DisableIRQSet",               Bench_DisableIRQSet },
+    { "NVIC_SetPendingIRQSet",            Bench_SetPendingIRQSet },
+    { "NVIC_ApplyConfig",                 Bench_ApplyConfig },
+    { "NVIC_SaveContext",                 Bench_NvicSave },
+    { "NVIC_RestoreContext",              Bench_NvicRestore },
+    { "NVIC_SetPriorityGrouping",         Bench_SetGrouping },
+    { "NVIC_GetPriorityGrouping",         Bench_GetGrouping },
+    { "NVIC_EncodePriority",              Bench_Encode },
+    { "NVIC_DecodePriority",              Bench_Decode },
+    { "NVIC_SetGroupedPriorityIRQ",       Bench_SetGroupedIRQ },
+    { "NVIC_GetGroupedPriorityIRQ",       Bench_GetGroupedIRQ },
+    { "NVIC_SetGroupedPriorityException", Bench_SetGroupedExc },
+    { "NVIC_GetGroupedPriorityException", Bench_GetGroupedExc },
+    { "NVIC_RelocateVectorTable",         Bench_Relocate },
+    { "NVIC_RegisterHandler",             Bench_RegisterHandler },
+    { "NVIC_RegisterExceptionHandler",    Bench_RegisterExcHandler },
+    { "NVIC_EnterCritical",               Bench_EnterCritical },
+    { "NVIC_ExitCritical",                Bench_ExitCritical },
+    { "NVIC_EnterCriticalCeiling",        Bench_EnterCeiling },
+    { "NVIC_ExitCriticalCeiling",         Bench_ExitCeiling },
+    { "NVIC_ConfigureSleep",              Bench_ConfigureSleep },
+    { "NVIC_SleepOnExit",                 Bench_SleepOnExit },
+    { "NVIC_RequestThreadWork",           Bench_RequestThreadWork },
+    { "NVIC_EnableException",             Bench_EnableException },
+    { "NVIC_DisableException",            Bench_DisableException },
+    { "NVIC_SetPriorityException",        Bench_SetPriorityExc },
+    { "NVIC_SPSCQueuePush+Pop",           Bench_SPSCPushPop },
+    { "NVIC_MPSCQueuePush+Pop",           Bench_MPSCPushPop },
+    { "SysTick_Init",                     Bench_SysTickInit },
+    { "SysTick_Handler",                  Bench_Handler },
+    { "SysTick_SetCallBack",              Bench_SetCallBack },
+    { "SysTick_Stop",                     Bench_Stop },
+    { "SysTick_Start",                    Bench_Start },
+    { "SysTick_DeInit",                   Bench_DeInit },
+    { "SysTick_StartBusyWait",            Bench_BusyWait },
+    { "SysTick_DelayCycles",              Bench_DelayCycles },
+    { "SysTick_DelayMicroseconds",        Bench_DelayMicroseconds },
+    { "SysTick_IdleTicks",                Bench_IdleTicks },
+    { "SysTick_TicklessIdle",             Bench_TicklessIdle },
+    { "SysTick_SaveContext",              Bench_SysTickSave },
+    { "SysTick_RestoreContext",           Bench_SysTickRestore },
+    { "SysTick_GetCycles",                Bench_GetCycles },
+    { "SysTick_GetTicks",                 Bench_GetTicks },
+    { "SysTick_GetMicroseconds",          Bench_GetMicroseconds },
+};
+
+#define BENCH_ENTRY_COUNT                    (sizeof(Bench_Entries) / sizeof(Bench_Entries[0]))
+
+/* One line of the report, the layout of the results file */
+typedef struct
+{
+    uint32 Reads;
+    uint32 Writes;
+    uint32 Bytes;
+    double Nanoseconds;
+} Bench_ResultType;
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+/* 1 ms tick at 16 MHz with eight periodic timers spread over the wheel, the NVIC and SysTick
+ * contexts are saved for the restore calls */
+static void Bench_Setup(void)
+{
+    uint32 i;
+
+    Host_Reset();
+    Host_Scb_Vtor = (uint32)(uintptr_t)Bench_VectorTable;
+    NVIC_IRQSetClear(&Bench_Set);
+    NVIC_IRQSetAdd(&Bench_Set, UART0_RXTX);
+    NVIC_IRQSetAdd(&Bench_Set, TIMER_0_SUBTIMER_A);
+    NVIC_IRQSetAdd(&Bench_Set, PWM_1_FAULT);
+    NVIC_IRQSetClear(&Bench_SetB);
+    NVIC_IRQSetAdd(&Bench_SetB, TIMER_0_SUBTIMER_A);
+    (void)NVIC_SPSCQueueInit(&Bench_Spsc, Bench_Events, 16);
+    (void)NVIC_MPSCQueueInit(&Bench_Mpsc, Bench_Cells, 16);
+
+    Host_SysTick_Reload = BENCH_RELOAD;
+    Host_SysTick_Current = 8000;
+    Host_SysTick_Ctrl = SYSTICK_CTRL_CLK_SRC_MASK | SYSTICK_CTRL_TICKINT_MASK | SYSTICK_CTRL_ENABLE_MASK;
+    SysTick_TimerInit();
+    SysTick_ScheduleInit();
+    for (i = 0; i < 8; i++) {
+        SysTick_TimerSetup(&Bench_Timers[i], Bench_Noop, NULL_PTR);
+        SysTick_TimerStart(&Bench_Timers[i], 1 + (i * 37), 1 + (i * 37));
+    }
+    NVIC_SaveContext(&Bench_NvicContext);
+    SysTick_SaveContext(&Bench_SysTickContext);
+    Host_SysTick_Ctrl = SYSTICK_CTRL_CLK_SRC_MASK | SYSTICK_CTRL_TICKINT_MASK | SYSTICK_CTRL_ENABLE_MASK;
+    Bench_State = 0;
+}
+
+static void Bench_Count(const Bench_EntryType *Entry, Bench_ResultType *Result)
+{
+    Entry->Call();                       /* Warm up, e.g. the first queue push */
+    Host_Register_Reads = 0;
+    Host_Register_Writes = 0;
+    Entry->Call();
+    Result->Reads = Host_Register_Reads;
+    Result->Writes = Host_Register_Writes;
+}
+
+static double Bench_Nanoseconds(const Bench_EntryType *Entry)
+{
+    struct timespec start;
+    struct timespec end;
+    uint32 i;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < BENCH_ITERATIONS; i++) {
+        Entry->Call();
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (((double)(end.tv_sec - start.tv_sec) * 1e9) + (double)(end.tv_nsec - start.tv_nsec)) / BENCH_ITERATIONS;
+}
+
+/* Finds the line of Name in a baseline or results file, "<name> <reads> <writes> [<bytes> <ns>]" with
+ * '#' starting a comment. Returns the number of values read after the name, 0 if Name is missing */
+static int Bench_Find(const char *Path, const char *Name, Bench_ResultType *Result)
+{
+    char line[160];
+    char name[BENCH_NAME_LENGTH];
+    unsigned int reads;
+    unsigned int writes;
+    unsigned int bytes;
+    double nanoseconds;
+    int values = 0;
+    FILE *file = fopen(Path, "r");
+
+    if (file == NULL) {
+        return 0;
+    }
+    while ((values == 0) && (fgets(line, sizeof(line), file) != NULL)) {
+        if (line[0] != '#') {
+            values = sscanf(line, "%47s %u %u %u %lf", name, &reads, &writes, &bytes, &nanoseconds) - 1;
+            if ((values < 2) || (strcmp(name, Name) != 0)) {
+                values = 0;
+            }
+        }
+    }
+    fclose(file);
+    if (values >= 2) {
+        Result->Reads = reads;
+        Result->Writes = writes;
+    }
+    if (values == 4) {
+        Result->Bytes = bytes;
+        Result->Nanoseconds = nanoseconds;
+    }
+    return values;
+}
+
+/* Code size from "nm -S" output, lines are "<address> <size> <type> <name>", 0 when not listed */
+static uint32 Bench_CodeSize(const char *Path, const char *Name)
+{
+    char line[160];
+    char name[BENCH_NAME_LENGTH];
+    char type;
+    unsigned long long address;
+    unsigned long long size;
+    uint32 bytes = 0;
+    FILE *file;
+
+    if (Path == NULL) {
+        return 0;
+    }
+    file = fopen(Path, "r");
+    if (file == NULL) {
+        return 0;
+    }
+    while ((bytes == 0) && (fgets(line, sizeof(line), file) != NULL)) {
+        if ((sscanf(line, "%llx %llx %c %47s", &address, &size, &type, name) == 4) &&
+            ((type == 'T') || (type == 't')) && (strcmp(name, Name) == 0)) {
+            bytes = (uint32)size;
+        }
+    }
+    fclose(file);
+    return bytes;
+}
+
+int main(int argc, char **argv)
+{
+    const char *baseline = NULL;
+    const char *sizes = NULL;
+    const char *times = NULL;
+    const char *output = "bench_results.txt";
+    FILE *results;
+    int failures = 0;
+    Bench_ResultType result;
+    Bench_ResultType limit;
+    Bench_ResultType timed;
+    int arg;
+    uint32 i;
+
+    for (arg = 1; arg < argc; arg += 2) {
+        if ((arg + 1 < argc) && (strcmp(argv[arg], "--check") == 0)) {
+            baseline = argv[arg + 1];
+        } else if ((arg + 1 < argc) && (strcmp(argv[arg], "--sizes") == 0)) {
+            sizes = argv[arg + 1];
+        } else if ((arg + 1 < argc) && (strcmp(argv[arg], "--times") == 0)) {
+            times = argv[arg + 1];
+        } else if ((arg + 1 < argc) && (strcmp(argv[arg], "--output") == 0)) {
+            output = argv[arg + 1];
+        } else {
+            fprintf(stderr, "usage: %s [--sizes <nm -S output>] [--times <results>] [--output <results>] "
+                            "[--check <baseline>]\n", argv[0]);
+            return 2;
+        }
+    }
+    if ((uintptr_t)Bench_VectorTable > 0xFFFFFFFF) {
+        fprintf(stderr, "%s: link with -no-pie, VTOR cannot hold the vector table address\n", argv[0]);
+        return 2;
+    }
+    results = fopen(output, "w");
+    if (results == NULL) {
+        fprintf(stderr, "%s: cannot write %s\n", argv[0], output);
+        return 2;
+    }
+
+    /* The results file is a valid baseline, copy it over tests/bench_baseline.txt to accept a change */
+    fprintf(results, "# Register reads and writes allowed per call, checked by the bench_regression test (nvic_bench --check).\n");
+    fprintf(results, "# Lower a value when a change saves an access, never raise one without a reason in the commit.\n");
+    fprintf(results, "# The host code bytes and host ns per call that follow are reported only.\n");
+    printf("%-34s %6s %6s %6s %10s\n", "call", "reads", "writes", "bytes", "host ns");
+    for (i = 0; i < BENCH_ENTRY_COUNT; i++) {
+        Bench_Setup();
+        Bench_Count(&Bench_Entries[i], &result);
+        result.Bytes = Bench_CodeSize(sizes, Bench_Entries[i].Name);
+        if (times == NULL) {
+            result.Nanoseconds = Bench_Nanoseconds(&Bench_Entries[i]);
+        } else if (Bench_Find(times, Bench_Entries[i].Name, &timed) == 4) {
+            result.Nanoseconds = timed.Nanoseconds;
+        } else {
+            result.Nanoseconds = 0;
+        }
+        fprintf(results, "%-34s %3u %3u %6u %10.1f\n", Bench_Entries[i].Name,
+                result.Reads, result.Writes, result.Bytes, result.Nanoseconds);
+        printf("%-34s %6u %6u %6u %10.1f", Bench_Entries[i].Name,
+               result.Reads, result.Writes, result.Bytes, result.Nanoseconds);
+        if (baseline != NULL) {
+            if (Bench_Find(baseline, Bench_Entries[i].Name, &limit) == 0) {
+                printf("  missing from baseline");
+                failures++;
+            } else if ((result.Reads > limit.Reads) || (result.Writes > limit.Writes)) {
+                printf("  REGRESSION, baseline %u %u", limit.Reads, limit.Writes);
+                failures++;
+            } else if ((result.Reads < limit.Reads) || (result.Writes < limit.Writes)) {
+                printf("  below baseline %u %u, lower it", limit.Reads, limit.Writes);
+            }
+        }
+        printf("\n");
+    }
+    fclose(results);
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,209 @@
+/******************************************************************************
+ *
+ * Module: Host
+ *
+ * File Name: host_core.c
+ *
+ * Description: Register file and core model behind the host build stubs
+ *
+ * Author: Ahmed Osama
+ *
+ ******************************************************************************/
+#include <string.h>
+#include "tm4c123gh6pm_registers.h"
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+volatile uint32 Host_Nvic_Iser[8];
+volatile uint32 Host_Nvic_Icer[8];
+volatile uint32 Host_Nvic_Ispr[8];
+volatile uint32 Host_Nvic_Icpr[8];
+volatile uint32 Host_Nvic_Iabr[8];
+volatile uint32 Host_Nvic_Ipr[60];
+volatile uint32 Host_Nvic_Stir;
+
+volatile uint32 Host_Scb_Icsr;
+volatile uint32 Host_Scb_Vtor;
+volatile uint32 Host_Scb_Aircr;
+volatile uint32 Host_Scb_Scr;
+volatile uint32 Host_Scb_Syspri[3];
+volatile uint32 Host_Scb_Shcsr;
+
+volatile uint32 Host_SysTick_Ctrl;
+volatile uint32 Host_SysTick_Reload;
+volatile uint32 Host_SysTick_Current;
+uint32 Host_SysTick_Step;
+
+volatile uint32 Host_Demcr;
+volatile uint32 Host_Dwt_Ctrl;
+volatile uint32 Host_Dwt_Cyccnt;
+
+uint32 Host_Primask;
+uint32 Host_Basepri;
+uint32 Host_Ipsr;
+
+uint32 Host_Register_Accesses;
+uint32 Host_Register_Reads;
+uint32 Host_Register_Writes;
+
+void (*Host_Wfi_Hook)(void);
+void (*Host_SysTick_Hook)(void);
+
+/* SysTick CTRL bits and the ICSR bit pending the SysTick exception */
+#define HOST_SYSTICK_ENABLE                  0x00000001
+#define HOST_SYSTICK_TICKINT                 0x00000002
+#define HOST_SYSTICK_COUNTFLAG               0x00010000
+#define HOST_ICSR_PENDSTSET                  0x04000000
+
+/* Every variable of the register file, the bounds Host_CountRead and Host_CountWrite check against */
+typedef struct
+{
+    const volatile void *Base;
+    uint32 Size;
+} Host_RegisterRangeType;
+
+#define HOST_REGISTER_RANGE(VARIABLE)        { &(VARIABLE), sizeof(VARIABLE) }
+
+static const Host_RegisterRangeType Host_RegisterFile[] =
+{
+    HOST_REGISTER_RANGE(Host_Nvic_Iser),
+    HOST_REGISTER_RANGE(Host_Nvic_Icer),
+    HOST_REGISTER_RANGE(Host_Nvic_Ispr),
+    HOST_REGISTER_RANGE(Host_Nvic_Icpr),
+    HOST_REGISTER_RANGE(Host_Nvic_Iabr),
+    HOST_REGISTER_RANGE(Host_Nvic_Ipr),
+    HOST_REGISTER_RANGE(Host_Nvic_Stir),
+    HOST_REGISTER_RANGE(Host_Scb_Icsr),
+    HOST_REGISTER_RANGE(Host_Scb_Vtor),
+    HOST_REGISTER_RANGE(Host_Scb_Aircr),
+    HOST_REGISTER_RANGE(Host_Scb_Scr),
+    HOST_REGISTER_RANGE(Host_Scb_Syspri),
+    HOST_REGISTER_RANGE(Host_Scb_Shcsr),
+    HOST_REGISTER_RANGE(Host_SysTick_Ctrl),
+    HOST_REGISTER_RANGE(Host_SysTick_Reload),
+    HOST_REGISTER_RANGE(Host_SysTick_Current),
+    HOST_REGISTER_RANGE(Host_Demcr),
+    HOST_REGISTER_RANGE(Host_Dwt_Ctrl),
+    HOST_REGISTER_RANGE(Host_Dwt_Cyccnt),
+};
+
+#define HOST_REGISTER_RANGE_COUNT            (sizeof(Host_RegisterFile) / sizeof(Host_RegisterFile[0]))
+
+/*******************************************************************************
+ *                              Private Functions                              *
+ *******************************************************************************/
+
+static boolean Host_IsRegister(const volatile void *Address)
+{
+    const volatile uint8 *address = (const volatile uint8 *)Address;
+    const volatile uint8 *base;
+    uint32 i;
+
+    for (i = 0; i < HOST_REGISTER_RANGE_COUNT; i++) {
+        base = (const volatile uint8 *)Host_RegisterFile[i].Base;
+        if ((address >= base) && (address < (base + Host_RegisterFile[i].Size))) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+void Host_Reset(void)
+{
+    memset((void *)Host_Nvic_Iser, 0, sizeof(Host_Nvic_Iser));
+    memset((void *)Host_Nvic_Icer, 0, sizeof(Host_Nvic_Icer));
+    memset((void *)Host_Nvic_Ispr, 0, sizeof(Host_Nvic_Ispr));
+    memset((void *)Host_Nvic_Icpr, 0, sizeof(Host_Nvic_Icpr));
+    memset((void *)Host_Nvic_Iabr, 0, sizeof(Host_Nvic_Iabr));
+    memset((void *)Host_Nvic_Ipr, 0, sizeof(Host_Nvic_Ipr));
+    memset((void *)Host_Scb_Syspri, 0, sizeof(Host_Scb_Syspri));
+    Host_Nvic_Stir = 0;
+    Host_Scb_Icsr = 0;
+    Host_Scb_Vtor = 0;
+    Host_Scb_Aircr = 0;
+    Host_Scb_Scr = 0;
+    Host_Scb_Shcsr = 0;
+    Host_SysTick_Ctrl = 0;
+    Host_SysTick_Reload = 0;
+    Host_SysTick_Current = 0;
+    Host_SysTick_Step = 0;
+    Host_Demcr = 0;
+    Host_Dwt_Ctrl = 0;
+    Host_Dwt_Cyccnt = 0;
+    Host_Primask = 0;
+    Host_Basepri = 0;
+    Host_Ipsr = 0;
+    Host_Register_Accesses = 0;
+    Host_Register_Reads = 0;
+    Host_Register_Writes = 0;
+    Host_Wfi_Hook = NULL_PTR;
+    Host_SysTick_Hook = NULL_PTR;
+}
+
+volatile uint32 *Host_Access(volatile uint32 *Register)
+{
+    Host_Register_Accesses++;
+    return Register;
+}
+
+/* The counter reaches 0 (COUNTFLAG, PENDSTSET with TICKINT) after CURRENT clocks, or after a full
+ * period when CURRENT is 0 since the first clock only loads RELOAD */
+volatile uint32 *Host_SysTickCurrent(void)
+{
+    uint32 period = (Host_SysTick_Reload & 0x00FFFFFF) + 1;
+    uint32 to_wrap = (Host_SysTick_Current == 0) ? period : Host_SysTick_Current;
+    uint32 step = Host_SysTick_Step;
+
+    Host_Register_Accesses++;
+    if ((Host_SysTick_Ctrl & HOST_SYSTICK_ENABLE) && (step > 0)) {
+        if (step < to_wrap) {
+            Host_SysTick_Current = to_wrap - step;
+        } else {
+            step -= to_wrap;
+            Host_SysTick_Current = (period - (step % period)) % period;
+            Host_SysTick_Ctrl |= HOST_SYSTICK_COUNTFLAG;
+            if (Host_SysTick_Ctrl & HOST_SYSTICK_TICKINT) {
+                Host_Scb_Icsr |= HOST_ICSR_PENDSTSET;
+            }
+        }
+    }
+    if (Host_SysTick_Hook != NULL_PTR) {
+        Host_SysTick_Hook();
+    }
+    return &Host_SysTick_Current;
+}
+
+void Host_CountRead(const volatile void *Address)
+{
+    if (Host_IsRegister(Address) != FALSE) {
+        Host_Register_Reads++;
+    }
+}
+
+void Host_CountWrite(const volatile void *Address)
+{
+    if (Host_IsRegister(Address) != FALSE) {
+        Host_Register_Writes++;
+    }
+}
+
+void Host_WriteBasepriMax(uint32 Value)
+{
+    Value &= 0xFF;
+    if ((Value != 0) && ((Host_Basepri == 0) || (Value < Host_Basepri))) {
+        Host_Basepri = Value;
+    }
+}
+
+void Host_WaitForInterrupt(void)
+{
+    if (Host_Wfi_Hook != NULL_PTR) {
+        Host_Wfi_Hook();
+    }
+}
@@ -0,0 +1,53 @@
+/******************************************************************************
+ *
+ * Module: Host
+ *
+ * File Name: host_test.h
+ *
+ * Description: Minimal check macros shared by the host test programs
+ *
+ * Author: Ahmed Osama
+ *
+ *******************************************************************************/
+
+#ifndef HOST_TEST_H_
+#define HOST_TEST_H_
+
+#include <stdio.h>
+#include "std_types.h"
+#include "tm4c123gh6pm_registers.h"
+
+/* Failed checks of the running program, its exit status */
+static uint32 Host_Test_Failures = 0;
+
+#define HOST_CHECK(CONDITION)                                                           \
+    do {                                                                                \
+        if (!(CONDITION)) {                                                             \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #CONDITION);        \
+            Host_Test_Failures++;                                                       \
+        }                                                                               \
+    } while (0)
+
+#define HOST_CHECK_EQ(ACTUAL, EXPECTED)                                                 \
+    do {                                                                                \
+        unsigned long long host_actual = (unsigned long long)(ACTUAL);                  \
+        unsigned long long host_expected = (unsigned long long)(EXPECTED);              \
+        if (host_actual != host_expected) {                                             \
+            printf("%s:%d: %s is 0x%llx, expected 0x%llx\n",                            \
+                   __FILE__, __LINE__, #ACTUAL, host_actual, host_expected);            \
+            Host_Test_Failures++;                                                       \
+        }                                                                               \
+    } while (0)
+
+/* Runs a test on a freshly reset register file */
+#define HOST_RUN(TEST)                                                                  \
+    do {                                                                                \
+        uint32 host_failures = Host_Test_Failures;                                      \
+        Host_Reset();                                                                   \
+        TEST();                                                                         \
+        printf("%-48s %s\n", #TEST, (Host_Test_Failures == host_failures) ? "ok" : "FAILED"); \
+    } while (0)
+
+#define HOST_RESULT()                        ((Host_Test_Failures == 0) ? 0 : 1)
+
+#endif /* HOST_TEST_H_ */
@@ -0,0 +1,76 @@
+/******************************************************************************
+ *
+ * Module: Host
+ *
+ * File Name: host_trace.c
+ *
+ * Description: Memory access hooks behind the register read and write counts
+ *              of the bench. The traced copy of the drivers is compiled with
+ *              -fsanitize=thread for its instrumentation only: the compiler
+ *              calls these hooks around every load and store, the sanitizer
+ *              runtime is never linked. Volatile accesses are passed on to the
+ *              register file counters of host_core.c, the rest are ignored.
+ *
+ * Author: Ahmed Osama
+ *
+ ******************************************************************************/
+#include "tm4c123gh6pm_registers.h"
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+/* Plain accesses never reach a register */
+#define HOST_TRACE_IGNORE(ACCESS)                                                       \
+    void __tsan_##ACCESS(void *Address);                                                \
+    void __tsan_##ACCESS(void *Address) { (void)Address; }
+
+/* Volatile accesses, the only kind the register macros produce, registers are always aligned */
+#define HOST_TRACE_COUNT(ACCESS, COUNTER)                                               \
+    void __tsan_volatile_##ACCESS(void *Address);                                       \
+    void __tsan_volatile_##ACCESS(void *Address) { COUNTER(Address); }
+
+#define HOST_TRACE_SIZE(SIZE)                                                           \
+    HOST_TRACE_IGNORE(read##SIZE)                                                       \
+    HOST_TRACE_IGNORE(write##SIZE)                                                      \
+    HOST_TRACE_IGNORE(unaligned_read##SIZE)                                             \
+    HOST_TRACE_IGNORE(unaligned_write##SIZE)                                            \
+    HOST_TRACE_COUNT(read##SIZE, Host_CountRead)                                        \
+    HOST_TRACE_COUNT(write##SIZE, Host_CountWrite)
+
+HOST_TRACE_SIZE(1)
+HOST_TRACE_SIZE(2)
+HOST_TRACE_SIZE(4)
+HOST_TRACE_SIZE(8)
+HOST_TRACE_SIZE(16)
+
+void __tsan_init(void);
+void __tsan_init(void)
+{
+}
+
+void __tsan_func_entry(void *Caller);
+void __tsan_func_entry(void *Caller)
+{
+    (void)Caller;
+}
+
+void __tsan_func_exit(void);
+void __tsan_func_exit(void)
+{
+}
+
+/* Structure copies, never volatile */
+void __tsan_read_range(void *Address, unsigned long Size);
+void __tsan_read_range(void *Address, unsigned long Size)
+{
+    (void)Address;
+    (void)Size;
+}
+
+void __tsan_write_range(void *Address, unsigned long Size);
+void __tsan_write_range(void *Address, unsigned long Size)
+{
+    (void)Address;
+    (void)Size;
+}
@@ -0,0 +1,221 @@
+/******************************************************************************
+ *
+ * Module: Host
+ *
+ * File Name: nvic_sim_report.c
+ *
+ * Description: Runs a workload file through the NVIC arbitration simulator
+ *              and prints the worst case and percentile latency per source.
+ *              The priorities are applied through the driver itself
+ *              (NVIC_SetPriorityIRQ, NVIC_SetPriorityException and
+ *              NVIC_SetPriorityGrouping) on the host register file.
+ *
+ *              Workload file, one directive per line, '#' starts a comment.
+ *              A source is an IRQ number or "systick".
+ *                duration <cycles>
+ *                prigroup <0..7>
+ *                priority <irq> <level>
+ *                systick  <period cycles> <service cycles> <level>
+ *                event    <time> <source> <service cycles>
+ *                periodic <source> <first time> <period> <service cycles>
+ *
+ * Author: Ahmed Osama
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "nvic_sim.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define REPORT_LINE_LENGTH                   256
+#define REPORT_MAX_PERIODIC                  64
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef struct
+{
+    uint16 Source;
+    uint64 First;
+    uint64 Period;
+    uint32 Service_Cycles;
+} Report_PeriodicType;
+
+typedef struct
+{
+    NVIC_SimEventType *Events;
+    uint32 Length;
+    uint32 Capacity;
+    Report_PeriodicType Periodic[REPORT_MAX_PERIODIC];
+    uint32 Periodic_Count;
+    NVIC_SimSysTickType SysTick;
+    uint64 Duration;
+} Report_WorkloadType;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+static NVIC_SimStatsType Report_Stats[NVIC_SIM_SOURCES];
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+static boolean Report_Source(const char *Text, uint16 *Source)
+{
+    char *end;
+    unsigned long irq;
+
+    if (strcmp(Text, "systick") == 0) {
+        *Source = NVIC_SIM_SYSTICK_SOURCE;
+        return TRUE;
+    }
+    irq = strtoul(Text, &end, 0);
+    if ((*end != '\0') || (irq >= NVIC_IRQ_COUNT)) {
+        return FALSE;
+    }
+    *Source = (uint16)irq;
+    return TRUE;
+}
+
+static void Report_AddEvent(Report_WorkloadType *Workload, uint64 Time, uint16 Source, uint32 Service_Cycles)
+{
+    if (Workload->Length == Workload->Capacity) {
+        Workload->Capacity = (Workload->Capacity == 0) ? 256 : (Workload->Capacity * 2);
+        Workload->Events = realloc(Workload->Events, Workload->Capacity * sizeof(NVIC_SimEventType));
+        if (Workload->Events == NULL) {
+            fprintf(stderr, "out of memory\n");
+            exit(2);
+        }
+    }
+    Workload->Events[Workload->Length].Time = Time;
+    Workload->Events[Workload->Length].Source = Source;
+    Workload->Events[Workload->Length].Service_Cycles = Service_Cycles;
+    Workload->Length++;
+}
+
+/* Trace order: time, then source so that equal times are reproducible */
+static int Report_CompareEvents(const void *A, const void *B)
+{
+    const NVIC_SimEventType *a = A;
+    const NVIC_SimEventType *b = B;
+
+    if (a->Time != b->Time) {
+        return (a->Time < b->Time) ? -1 : 1;
+    }
+    return (int)a->Source - (int)b->Source;
+}
+
+static boolean Report_Parse(FILE *File, Report_WorkloadType *Workload)
+{
+    char line[REPORT_LINE_LENGTH];
+    char source[32];
+    unsigned long long a;
+    unsigned long long b;
+    unsigned long long c;
+    uint32 number = 0;
+    uint16 id;
+
+    while (fgets(line, sizeof(line), File) != NULL) {
+        char *text = line;
+        number++;
+        text[strcspn(text, "#\r\n")] = '\0';
+        text += strspn(text, " \t");
+        if (*text == '\0') {
+            continue;
+        }
+        if (sscanf(text, "duration %llu", &a) == 1) {
+            Workload->Duration = a;
+        } else if (sscanf(text, "prigroup %llu", &a) == 1 && a <= PRIGROUP_7) {
+            NVIC_SetPriorityGrouping((NVIC_PriorityGroupType)a);
+        } else if (sscanf(text, "priority %31s %llu", source, &a) == 2 && Report_Source(source, &id) &&
+                   id != NVIC_SIM_SYSTICK_SOURCE && a <= NVIC_PRIORITY_LEVEL_MASK) {
+            NVIC_SetPriorityIRQ((NVIC_IRQType)id, (NVIC_IRQPriorityType)a);
+        } else if (sscanf(text, "systick %llu %llu %llu", &a, &b, &c) == 3 && c <= NVIC_PRIORITY_LEVEL_MASK) {
+            Workload->SysTick.Period_Cycles = (uint32)a;
+            Workload->SysTick.Service_Cycles = (uint32)b;
+            NVIC_SetPriorityException(EXCEPTION_SYSTICK_TYPE, (NVIC_ExceptionPriorityType)c);
+        } else if (sscanf(text, "event %llu %31s %llu", &a, source, &b) == 3 && Report_Source(source, &id)) {
+            Report_AddEvent(Workload, a, id, (uint32)b);
+        } else if (sscanf(text, "periodic %31s %llu %llu %llu", source, &a, &b, &c) == 4 && Report_Source(source, &id) &&
+                   b != 0 && Workload->Periodic_Count < REPORT_MAX_PERIODIC) {
+            Report_PeriodicType *periodic = &Workload->Periodic[Workload->Periodic_Count++];
+            periodic->Source = id;
+            periodic->First = a;
+            periodic->Period = b;
+            periodic->Service_Cycles = (uint32)c;
+        } else {
+            fprintf(stderr, "line %u: cannot parse \"%s\"\n", number, text);
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static void Report_Print(const Report_WorkloadType *Workload)
+{
+    uint32 source;
+
+    printf("%-8s %8s %6s %8s %6s %6s %6s %8s %6s %6s\n",
+           "source", "runs", "lost", "preempt", "chain", "late", "max", "mean", "p50", "p99");
+    for (source = 0; source < NVIC_SIM_SOURCES; source++) {
+        const NVIC_SimStatsType *stats = &Report_Stats[source];
+        char name[16];
+
+        if ((stats->Count == 0) && (stats->Lost == 0)) {
+            continue;
+        }
+        if (source == NVIC_SIM_SYSTICK_SOURCE) {
+            snprintf(name, sizeof(name), "systick");
+        } else {
+            snprintf(name, sizeof(name), "irq%u", source);
+        }
+        printf("%-8s %8u %6u %8u %6u %6u %6u %8.1f %6u %6u\n", name, stats->Count, stats->Lost,
+               stats->Preemptions, stats->Tail_Chains, stats->Late_Arrivals, stats->Max_Latency_Cycles,
+               (stats->Count != 0) ? ((double)stats->Total_Latency_Cycles / stats->Count) : 0.0,
+               NVIC_SimPercentile(stats, 500), NVIC_SimPercentile(stats, 990));
+    }
+    printf("%u requests over %llu cycles\n", Workload->Length, (unsigned long long)Workload->Duration);
+}
+
+int main(int argc, char **argv)
+{
+    static Report_WorkloadType workload;
+    FILE *file;
+    uint32 i;
+    uint64 time;
+
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <workload file>\n", argv[0]);
+        return 2;
+    }
+    file = fopen(argv[1], "r");
+    if (file == NULL) {
+        perror(argv[1]);
+        return 2;
+    }
+    Host_Reset();
+    if (Report_Parse(file, &workload) == FALSE) {
+        fclose(file);
+        return 2;
+    }
+    fclose(file);
+
+    for (i = 0; i < workload.Periodic_Count; i++) {
+        for (time = workload.Periodic[i].First; time < workload.Duration; time += workload.Periodic[i].Period) {
+            Report_AddEvent(&workload, time, workload.Periodic[i].Source, workload.Periodic[i].Service_Cycles);
+        }
+    }
+    qsort(workload.Events, workload.Length, sizeof(NVIC_SimEventType), Report_CompareEvents);
+
+    NVIC_SimRun(workload.Events, workload.Length, &workload.SysTick, workload.Duration, Report_Stats);
+    Report_Print(&workload);
+    free(workload.Events);
+    return 0;
+}
@@ -0,0 +1,152 @@
+/******************************************************************************
+ *
+ * Module: Host
+ *
+ * File Name: tm4c123gh6pm_registers.h
+ *
+ * Description: Host build stand-in for the TM4C123 register header. Every
+ *              register the drivers touch is backed by a plain variable in
+ *              host_core.c, and the core instructions (PRIMASK, BASEPRI,
+ *              IPSR, LDREX/STREX, WFI, barriers) are modelled in C.
+ *
+ * Author: Ahmed Osama
+ *
+ *******************************************************************************/
+
+#ifndef TM4C123GH6PM_REGISTERS_H_
+#define TM4C123GH6PM_REGISTERS_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                              Host Register File                             *
+ *******************************************************************************/
+
+/* NVIC banks sized for the architectural maximum of 240 IRQ lines */
+extern volatile uint32 Host_Nvic_Iser[8];
+extern volatile uint32 Host_Nvic_Icer[8];
+extern volatile uint32 Host_Nvic_Ispr[8];
+extern volatile uint32 Host_Nvic_Icpr[8];
+extern volatile uint32 Host_Nvic_Iabr[8];
+extern volatile uint32 Host_Nvic_Ipr[60];
+extern volatile uint32 Host_Nvic_Stir;
+
+/* System Control Block */
+extern volatile uint32 Host_Scb_Icsr;
+extern volatile uint32 Host_Scb_Vtor;
+extern volatile uint32 Host_Scb_Aircr;
+extern volatile uint32 Host_Scb_Scr;
+extern volatile uint32 Host_Scb_Syspri[3];
+extern volatile uint32 Host_Scb_Shcsr;
+
+/* SysTick, CURRENT counts down by Host_SysTick_Step cycles on every access while ENABLE is set */
+extern volatile uint32 Host_SysTick_Ctrl;
+extern volatile uint32 Host_SysTick_Reload;
+extern volatile uint32 Host_SysTick_Current;
+extern uint32 Host_SysTick_Step;
+
+/* Debug and trace */
+extern volatile uint32 Host_Demcr;
+extern volatile uint32 Host_Dwt_Ctrl;
+extern volatile uint32 Host_Dwt_Cyccnt;
+
+/* Core special registers */
+extern uint32 Host_Primask;
+extern uint32 Host_Basepri;
+extern uint32 Host_Ipsr;
+
+/* Number of register references made by the drivers since the last Host_Reset,
+ * a read-modify-write such as REG |= MASK counts as one */
+extern uint32 Host_Register_Accesses;
+
+/* Loads and stores of the register file since the last Host_Reset, a read-modify-write counts
+ * once in each. Only counted in code built with the access tracing of tests/host_trace.c */
+extern uint32 Host_Register_Reads;
+extern uint32 Host_Register_Writes;
+
+/* Called by Wait_For_Interrupt, lets a test run the "interrupt" that wakes the core */
+extern void (*Host_Wfi_Hook)(void);
+
+/* Called after every access of SYSTICK_CURRENT_REG, lets a test preempt the driver at that point */
+extern void (*Host_SysTick_Hook)(void);
+
+// Clears the register file, the core registers and the access counters
+void Host_Reset(void);
+
+// Counts one access and returns Register
+volatile uint32 *Host_Access(volatile uint32 *Register);
+
+// Counts one access and returns the SysTick CURRENT register after the counter moved on
+volatile uint32 *Host_SysTickCurrent(void);
+
+// Counts one register read if Address lies in the register file
+void Host_CountRead(const volatile void *Address);
+
+// Counts one register write if Address lies in the register file
+void Host_CountWrite(const volatile void *Address);
+
+// BASEPRI_MAX semantics: only a non-zero value that masks more than the current BASEPRI is taken
+void Host_WriteBasepriMax(uint32 Value);
+
+// Wait_For_Interrupt: runs Host_Wfi_Hook if one is installed
+void Host_WaitForInterrupt(void);
+
+/*******************************************************************************
+ *                              Register Mapping                               *
+ *******************************************************************************/
+
+#define HOST_REG(VARIABLE)                   (*Host_Access(&(VARIABLE)))
+#define HOST_BANK(VARIABLE)                  Host_Access(VARIABLE)
+
+#define NVIC_ISER_REGS                       HOST_BANK(Host_Nvic_Iser)
+#define NVIC_ICER_REGS                       HOST_BANK(Host_Nvic_Icer)
+#define NVIC_ISPR_REGS                       HOST_BANK(Host_Nvic_Ispr)
+#define NVIC_ICPR_REGS                       HOST_BANK(Host_Nvic_Icpr)
+#define NVIC_IABR_REGS                       HOST_BANK(Host_Nvic_Iabr)
+#define NVIC_IPR_REGS                        ((volatile uint8 *)HOST_BANK(Host_Nvic_Ipr))
+#define NVIC_STIR_REG                        HOST_REG(Host_Nvic_Stir)
+
+#define NVIC_ICSR_REG                        HOST_REG(Host_Scb_Icsr)
+#define NVIC_VTOR_REG                        HOST_REG(Host_Scb_Vtor)
+#define NVIC_AIRCR_REG                       HOST_REG(Host_Scb_Aircr)
+#define NVIC_SCR_REG                         HOST_REG(Host_Scb_Scr)
+#define NVIC_SYSPRI_REGS                     HOST_BANK(Host_Scb_Syspri)
+#define NVIC_SYSTEM_PRI1_REG                 HOST_REG(Host_Scb_Syspri[0])
+#define NVIC_SYSTEM_PRI2_REG                 HOST_REG(Host_Scb_Syspri[1])
+#define NVIC_SYSTEM_PRI3_REG                 HOST_REG(Host_Scb_Syspri[2])
+#define NVIC_SYSTEM_SYSHNDCTRL               HOST_REG(Host_Scb_Shcsr)
+
+#define SYSTICK_CTRL_REG                     HOST_REG(Host_SysTick_Ctrl)
+#define SYSTICK_RELOAD_REG                   HOST_REG(Host_SysTick_Reload)
+#define SYSTICK_CURRENT_REG                  (*Host_SysTickCurrent())
+
+#define NVIC_DEMCR_REG                       HOST_REG(Host_Demcr)
+#define NVIC_DWT_CTRL_REG                    HOST_REG(Host_Dwt_Ctrl)
+#define NVIC_DWT_CYCCNT_REG                  HOST_REG(Host_Dwt_Cyccnt)
+
+/*******************************************************************************
+ *                              Core Instructions                              *
+ *******************************************************************************/
+
+#define Enable_Exceptions()                  ((void)(Host_Primask = 0))
+#define Disable_Exceptions()                 ((void)(Host_Primask = 1))
+#define Enable_Faults()                      ((void)0)
+#define Disable_Faults()                     ((void)0)
+#define Wait_For_Interrupt()                 Host_WaitForInterrupt()
+#define Data_Sync_Barrier()                  ((void)0)
+#define Inst_Sync_Barrier()                  ((void)0)
+#define Data_Memory_Barrier()                __asm volatile ("" ::: "memory")
+
+#define NVIC_READ_PRIMASK(VALUE)             ((VALUE) = Host_Primask)
+#define NVIC_WRITE_PRIMASK(VALUE)            ((void)(Host_Primask = (VALUE)))
+#define NVIC_READ_BASEPRI(VALUE)             ((VALUE) = Host_Basepri)
+#define NVIC_WRITE_BASEPRI(VALUE)            ((void)(Host_Basepri = (VALUE)))
+#define NVIC_WRITE_BASEPRI_MAX(VALUE)        Host_WriteBasepriMax(VALUE)
+#define NVIC_READ_IPSR(VALUE)                ((VALUE) = Host_Ipsr)
+
+/* Single core, nothing can come between the load and the store */
+#define NVIC_LOAD_EXCLUSIVE(VALUE, ADDRESS)            ((VALUE) = *(ADDRESS))
+#define NVIC_STORE_EXCLUSIVE(FAILED, ADDRESS, VALUE)   ((void)(*(ADDRESS) = (VALUE)), (FAILED) = 0)
+#define NVIC_CLEAR_EXCLUSIVE()                         ((void)0)
+
+#endif /* TM4C123GH6PM_REGISTERS_H_ */
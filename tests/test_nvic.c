@@ -0,0 +1,317 @@
+/******************************************************************************
+ *
+ * Module: Host
+ *
+ * File Name: test_nvic.c
+ *
+ * Description: Register level tests of the NVIC driver on the host build
+ *
+ * Author: Ahmed Osama
+ *
+ ******************************************************************************/
+#include "host_test.h"
+#include "nvic.h"
+#include "nvic_tasks.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Background pattern, a read-modify-write would carry it into the written word */
+#define TEST_SENTINEL                        0xA5A5A5A5
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+/* First and high bits of word 0, words 1 and 2, and the last line of the TM4C123 in word 4 */
+static const NVIC_IRQType Test_IRQs[] =
+{
+    GPIO_PORT_A, GPIO_PORT_F, UART2_RXTX, PWM_1_FAULT, (NVIC_IRQType)(NVIC_DEVICE_IRQ_LINES - 1)
+};
+
+#define TEST_IRQ_COUNT                       (sizeof(Test_IRQs) / sizeof(Test_IRQs[0]))
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+static void Test_Fill(volatile uint32 *Bank, uint32 Value)
+{
+    uint32 i;
+    for (i = 0; i < 8; i++) {
+        Bank[i] = Value;
+    }
+}
+
+/* The call must be one store of exactly the IRQ's bit mask to its word, nothing else touched */
+static void Test_SingleStore(void (*Call)(NVIC_IRQType), volatile uint32 *Bank)
+{
+    uint32 irq;
+    uint32 i;
+
+    for (irq = 0; irq < TEST_IRQ_COUNT; irq++) {
+        Test_Fill(Bank, TEST_SENTINEL);
+        Host_Register_Accesses = 0;
+        Host_Primask = 1;
+        Call(Test_IRQs[irq]);
+        HOST_CHECK_EQ(Host_Register_Accesses, 1);
+        HOST_CHECK_EQ(Host_Primask, 1);
+        for (i = 0; i < 8; i++) {
+            HOST_CHECK_EQ(Bank[i], (i == NVIC_IRQ_REG_INDEX(Test_IRQs[irq])) ? NVIC_IRQ_BIT_MASK(Test_IRQs[irq]) : TEST_SENTINEL);
+        }
+    }
+}
+
+static void Test_EnableIRQSingleStore(void)
+{
+    Test_SingleStore(NVIC_EnableIRQ, Host_Nvic_Iser);
+}
+
+static void Test_DisableIRQSingleStore(void)
+{
+    Test_SingleStore(NVIC_DisableIRQ, Host_Nvic_Icer);
+}
+
+static void Test_SetPendingSingleStore(void)
+{
+    Test_SingleStore(NVIC_SetPending, Host_Nvic_Ispr);
+}
+
+static void Test_ClearPendingSingleStore(void)
+{
+    Test_SingleStore(NVIC_ClearPending, Host_Nvic_Icpr);
+}
+
+static void Test_PendingAndActiveRead(void)
+{
+    Host_Nvic_Ispr[NVIC_IRQ_REG_INDEX(UART4_RXTX)] = NVIC_IRQ_BIT_MASK(UART4_RXTX) | NVIC_IRQ_BIT_MASK(UART3_RXTX);
+    Host_Nvic_Iabr[NVIC_IRQ_REG_INDEX(GPIO_PORT_F)] = NVIC_IRQ_BIT_MASK(GPIO_PORT_F);
+    HOST_CHECK(NVIC_IsPending(UART4_RXTX) == TRUE);
+    HOST_CHECK(NVIC_IsPending(UART0_RXTX) == FALSE);
+    HOST_CHECK(NVIC_IsActive(GPIO_PORT_F) == TRUE);
+    HOST_CHECK(NVIC_IsActive(GPIO_PORT_A) == FALSE);
+}
+
+/* One store per non-empty word, empty words are not written at all */
+static void Test_EnableIRQSetStores(void)
+{
+    NVIC_IRQSetType set;
+
+    NVIC_IRQSetClear(&set);
+    NVIC_IRQSetAdd(&set, UART0_RXTX);
+    NVIC_IRQSetAdd(&set, GPIO_PORT_A);
+    NVIC_IRQSetAdd(&set, PWM_1_FAULT);          /* Word 2, words 1, 3 and 4 stay empty */
+    Test_Fill(Host_Nvic_Iser, TEST_SENTINEL);
+    Host_Register_Accesses = 0;
+    NVIC_EnableIRQSet(&set);
+    HOST_CHECK_EQ(Host_Register_Accesses, 2);
+    HOST_CHECK_EQ(Host_Nvic_Iser[0], NVIC_IRQ_BIT_MASK(UART0_RXTX) | NVIC_IRQ_BIT_MASK(GPIO_PORT_A));
+    HOST_CHECK_EQ(Host_Nvic_Iser[1], TEST_SENTINEL);
+    HOST_CHECK_EQ(Host_Nvic_Iser[NVIC_IRQ_REG_INDEX(PWM_1_FAULT)], NVIC_IRQ_BIT_MASK(PWM_1_FAULT));
+}
+
+static void Test_TriggerIRQ(void)
+{
+    NVIC_TriggerIRQ(UART4_RXTX);
+    HOST_CHECK_EQ(Host_Nvic_Stir, UART4_RXTX);
+}
+
+/* Each IRQ owns one byte lane of IPR, a write leaves the other three lanes of its word alone */
+static void Test_PriorityByteLane(void)
+{
+    volatile const uint8 *lanes = (volatile const uint8 *)Host_Nvic_Ipr;
+    uint32 lane;
+    uint32 i;
+
+    for (lane = 0; lane < 4; lane++) {
+        NVIC_IRQType irq = (NVIC_IRQType)(8 + lane);           /* IRQs 8 .. 11 share PRI2 */
+
+        for (i = 0; i < 60; i++) {
+            Host_Nvic_Ipr[i] = TEST_SENTINEL;
+        }
+        Host_Register_Accesses = 0;
+        NVIC_SetPriorityIRQ(irq, Priority_6);
+        HOST_CHECK_EQ(Host_Register_Accesses, 1);
+        for (i = 0; i < (60 * 4); i++) {
+            HOST_CHECK_EQ(lanes[i], (i == (uint32)irq) ? (6 << (8 - NVIC_PRIORITY_BITS)) : 0xA5);
+        }
+        HOST_CHECK_EQ(NVIC_GetPriorityIRQ(irq), Priority_6);
+    }
+}
+
+/* Only the implemented upper bits are written, a level above the mask is cut to its implemented bits */
+static void Test_PriorityImplementedBits(void)
+{
+    volatile const uint8 *lanes = (volatile const uint8 *)Host_Nvic_Ipr;
+    uint32 level;
+
+    for (level = 0; level <= NVIC_PRIORITY_LEVEL_MASK; level++) {
+        NVIC_SetPriorityIRQ(PWM_1_FAULT, (NVIC_IRQPriorityType)level);
+        HOST_CHECK_EQ(lanes[PWM_1_FAULT], level << NVIC_PRIORITY_SHIFT);
+        HOST_CHECK_EQ(NVIC_GetPriorityIRQ(PWM_1_FAULT), level);
+    }
+    NVIC_SetPriorityIRQ(PWM_1_FAULT, (NVIC_IRQPriorityType)(NVIC_PRIORITY_LEVEL_MASK + 2));
+    HOST_CHECK_EQ(lanes[PWM_1_FAULT], 1 << NVIC_PRIORITY_SHIFT);
+}
+
+/* PRIGROUP is written with VECTKEY, the other AIRCR bits are kept */
+static void Test_PriorityGroupingRegister(void)
+{
+    uint32 group;
+
+    for (group = PRIGROUP_0; group <= PRIGROUP_7; group++) {
+        Host_Scb_Aircr = 0xFA050000 | 0x00008000;           /* Read back VECTKEYSTAT, ENDIANNESS set */
+        NVIC_SetPriorityGrouping((NVIC_PriorityGroupType)group);
+        HOST_CHECK_EQ(Host_Scb_Aircr, NVIC_AIRCR_VECTKEY | 0x00008000 | (group << NVIC_AIRCR_PRIGROUP_BITS_POS));
+        HOST_CHECK_EQ(NVIC_GetPriorityGrouping(), group);
+    }
+}
+
+/* With 3 implemented bits PRIGROUP 0 .. 4 leaves no sub-priority bit, 5, 6 and 7 take 1, 2 and 3 */
+static void Test_PriorityEncodeDecode(void)
+{
+    NVIC_IRQPriorityType priority;
+    uint32 group;
+    uint32 preempt;
+    uint32 sub;
+    uint8 preempt_out;
+    uint8 sub_out;
+
+    for (group = PRIGROUP_0; group <= PRIGROUP_7; group++) {
+        uint32 sub_bits = ((group + NVIC_PRIORITY_BITS) < 7) ? 0 : (group + NVIC_PRIORITY_BITS - 7);
+        uint32 preempt_bits = NVIC_PRIORITY_BITS - sub_bits;
+
+        NVIC_SetPriorityGrouping((NVIC_PriorityGroupType)group);
+        for (preempt = 0; preempt < (1u << preempt_bits); preempt++) {
+            for (sub = 0; sub < (1u << sub_bits); sub++) {
+                HOST_CHECK(NVIC_EncodePriority((uint8)preempt, (uint8)sub, &priority) == TRUE);
+                HOST_CHECK_EQ(priority, (preempt << sub_bits) | sub);
+                NVIC_DecodePriority(priority, &preempt_out, &sub_out);
+                HOST_CHECK_EQ(preempt_out, preempt);
+                HOST_CHECK_EQ(sub_out, sub);
+            }
+        }
+        HOST_CHECK(NVIC_EncodePriority((uint8)(1u << preempt_bits), 0, &priority) == FALSE);
+        HOST_CHECK(NVIC_EncodePriority(0, (uint8)(1u << sub_bits), &priority) == FALSE);
+    }
+}
+
+static void Test_GroupedPriorityIRQAndException(void)
+{
+    uint8 preempt;
+    uint8 sub;
+
+    NVIC_SetPriorityGrouping(PRIGROUP_5);                   /* xx.y */
+    HOST_CHECK(NVIC_SetGroupedPriorityIRQ(UART0_RXTX, 2, 1) == TRUE);
+    HOST_CHECK_EQ(NVIC_GetPriorityIRQ(UART0_RXTX), Priority_5);
+    NVIC_GetGroupedPriorityIRQ(UART0_RXTX, &preempt, &sub);
+    HOST_CHECK_EQ(preempt, 2);
+    HOST_CHECK_EQ(sub, 1);
+    HOST_CHECK(NVIC_SetGroupedPriorityIRQ(UART0_RXTX, 4, 0) == FALSE);
+    HOST_CHECK_EQ(NVIC_GetPriorityIRQ(UART0_RXTX), Priority_5);
+
+    HOST_CHECK(NVIC_SetGroupedPriorityException(EXCEPTION_SYSTICK_TYPE, 3, 1) == TRUE);
+    HOST_CHECK_EQ(Host_Scb_Syspri[2], (uint32)7 << SYSTICK_PRIORITY_BITS_POS);
+    HOST_CHECK(NVIC_GetGroupedPriorityException(EXCEPTION_SYSTICK_TYPE, &preempt, &sub) == TRUE);
+    HOST_CHECK_EQ(preempt, 3);
+    HOST_CHECK_EQ(sub, 1);
+    HOST_CHECK(NVIC_SetGroupedPriorityException(EXCEPTION_HARD_FAULT_TYPE, 0, 0) == FALSE);
+    HOST_CHECK(NVIC_GetGroupedPriorityException(EXCEPTION_NMI_TYPE, &preempt, &sub) == FALSE);
+}
+
+/* Restore replays the saved words with one store each and disables what was enabled after the save */
+static void Test_ContextRoundTrip(void)
+{
+    NVIC_ContextType context;
+    uint32 saved_ipr[NVIC_IPR_REG_COUNT];
+    uint32 i;
+
+    for (i = 0; i < NVIC_IRQ_REG_COUNT; i++) {
+        Host_Nvic_Iser[i] = 0x01010101 << i;
+    }
+    for (i = 0; i < NVIC_IPR_REG_COUNT; i++) {
+        Host_Nvic_Ipr[i] = saved_ipr[i] = 0x20406080 + i;
+    }
+    Host_Scb_Syspri[0] = 0x00206040;
+    Host_Scb_Syspri[1] = 0xA0000000;
+    Host_Scb_Syspri[2] = 0xE0C00000;
+    Host_Scb_Shcsr = NVIC_SYSHNDCTRL_ENABLE_MASK & ~BUS_FAULT_ENABLE_MASK;
+    Host_Scb_Aircr = 0xFA050000 | (PRIGROUP_5 << NVIC_AIRCR_PRIGROUP_BITS_POS);
+    NVIC_SaveContext(&context);
+
+    /* Deep sleep loses the NVIC state, the boot code enabled something else meanwhile */
+    for (i = 0; i < 8; i++) {
+        Host_Nvic_Iser[i] = 0xFFFFFFFF;
+        Host_Nvic_Icer[i] = 0;
+    }
+    for (i = 0; i < 60; i++) {
+        Host_Nvic_Ipr[i] = 0;
+    }
+    for (i = 0; i < 3; i++) {
+        Host_Scb_Syspri[i] = 0;
+    }
+    Host_Scb_Shcsr = BUS_FAULT_ENABLE_MASK | 0x00000800;    /* SVCALLPEND is not part of the context */
+    Host_Scb_Aircr = 0xFA050000;
+
+    Host_Register_Accesses = 0;
+    NVIC_RestoreContext(&context);
+    HOST_CHECK_EQ(Host_Register_Accesses, (2 * NVIC_IRQ_REG_COUNT) + NVIC_IPR_REG_COUNT + NVIC_SYSPRI_REG_COUNT + 3);
+    HOST_CHECK_EQ(Host_Primask, 0);
+    for (i = 0; i < NVIC_IRQ_REG_COUNT; i++) {
+        HOST_CHECK_EQ(Host_Nvic_Icer[i], (uint32)~(0x01010101u << i));
+        HOST_CHECK_EQ(Host_Nvic_Iser[i], 0x01010101 << i);
+    }
+    for (i = 0; i < NVIC_IPR_REG_COUNT; i++) {
+        HOST_CHECK_EQ(Host_Nvic_Ipr[i], saved_ipr[i]);
+    }
+    HOST_CHECK_EQ(Host_Scb_Syspri[0], 0x00206040);
+    HOST_CHECK_EQ(Host_Scb_Syspri[1], 0xA0000000);
+    HOST_CHECK_EQ(Host_Scb_Syspri[2], 0xE0C00000);
+    HOST_CHECK_EQ(Host_Scb_Shcsr, (NVIC_SYSHNDCTRL_ENABLE_MASK & ~BUS_FAULT_ENABLE_MASK) | 0x00000800);
+    HOST_CHECK_EQ(Host_Scb_Aircr, NVIC_AIRCR_VECTKEY | (PRIGROUP_5 << NVIC_AIRCR_PRIGROUP_BITS_POS));
+    HOST_CHECK_EQ(NVIC_GetPriorityIRQ((NVIC_IRQType)1), 0x60 >> NVIC_PRIORITY_SHIFT);
+}
+
+/* BASEPRI 0 masks nothing, a Priority_0 task locks with PRIMASK and nests inside an outer ceiling */
+static void Test_TaskLockPriorityZero(void)
+{
+    NVIC_TaskType task;
+    NVIC_CriticalStateType outer;
+    NVIC_CriticalStateType inner;
+
+    task.Priority = Priority_3;
+    outer = NVIC_TaskLock(&task);
+    HOST_CHECK_EQ(Host_Basepri, Priority_3 << NVIC_PRIORITY_SHIFT);
+    HOST_CHECK_EQ(Host_Primask, 0);
+
+    task.Priority = Priority_0;
+    inner = NVIC_TaskLock(&task);
+    HOST_CHECK_EQ(Host_Primask, 1);
+    HOST_CHECK_EQ(Host_Basepri, Priority_3 << NVIC_PRIORITY_SHIFT);
+
+    NVIC_TaskUnlock(inner);
+    HOST_CHECK_EQ(Host_Primask, 0);
+    HOST_CHECK_EQ(Host_Basepri, Priority_3 << NVIC_PRIORITY_SHIFT);
+    NVIC_TaskUnlock(outer);
+    HOST_CHECK_EQ(Host_Basepri, 0);
+}
+
+int main(void)
+{
+    HOST_RUN(Test_EnableIRQSingleStore);
+    HOST_RUN(Test_DisableIRQSingleStore);
+    HOST_RUN(Test_SetPendingSingleStore);
+    HOST_RUN(Test_ClearPendingSingleStore);
+    HOST_RUN(Test_PendingAndActiveRead);
+    HOST_RUN(Test_EnableIRQSetStores);
+    HOST_RUN(Test_TriggerIRQ);
+    HOST_RUN(Test_PriorityByteLane);
+    HOST_RUN(Test_PriorityImplementedBits);
+    HOST_RUN(Test_PriorityGroupingRegister);
+    HOST_RUN(Test_PriorityEncodeDecode);
+    HOST_RUN(Test_GroupedPriorityIRQAndException);
+    HOST_RUN(Test_ContextRoundTrip);
+    HOST_RUN(Test_TaskLockPriorityZero);
+    return HOST_RESULT();
+}
@@ -0,0 +1,130 @@
+/******************************************************************************
+ *
+ * Module: Host
+ *
+ * File Name: test_nvic_sim.c
+ *
+ * Description: Known answer tests of the NVIC arbitration simulator. Every
+ *              expected latency is worked out by hand from the entry, tail
+ *              chain and late arrival times in nvic_sim.h.
+ *
+ * Author: Ahmed Osama
+ *
+ ******************************************************************************/
+#include "host_test.h"
+#include "nvic_sim.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define TEST_IRQ_A                           GPIO_PORT_A
+#define TEST_IRQ_B                           GPIO_PORT_B
+#define TEST_DURATION                        10000
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+static NVIC_SimStatsType Test_Stats[NVIC_SIM_SOURCES];
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+static void Test_Run(const NVIC_SimEventType *Trace, uint32 Length, NVIC_IRQPriorityType Priority_A,
+                     NVIC_IRQPriorityType Priority_B)
+{
+    NVIC_SetPriorityIRQ(TEST_IRQ_A, Priority_A);
+    NVIC_SetPriorityIRQ(TEST_IRQ_B, Priority_B);
+    NVIC_SimRun(Trace, Length, NULL_PTR, TEST_DURATION, Test_Stats);
+}
+
+/* A enters at 100 + 12 and runs until 162, B lands at 130 and preempts it: 12 cycles of entry */
+static void Test_Preemption(void)
+{
+    static const NVIC_SimEventType trace[] = { { 100, TEST_IRQ_A, 50 }, { 130, TEST_IRQ_B, 20 } };
+
+    Test_Run(trace, 2, Priority_5, Priority_1);
+    HOST_CHECK_EQ(Test_Stats[TEST_IRQ_A].Max_Latency_Cycles, NVIC_SIM_ENTRY_CYCLES);
+    HOST_CHECK_EQ(Test_Stats[TEST_IRQ_B].Max_Latency_Cycles, NVIC_SIM_ENTRY_CYCLES);
+    HOST_CHECK_EQ(Test_Stats[TEST_IRQ_B].Preemptions, 1);
+    HOST_CHECK_EQ(Test_Stats[TEST_IRQ_B].Tail_Chains, 0);
+}
+
+/* Same trace with B below A: B waits for A to finish at 162 and tail-chains, 162 + 6 - 130 */
+static void Test_TailChain(void)
+{
+    static const NVIC_SimEventType trace[] = { { 100, TEST_IRQ_A, 50 }, { 130, TEST_IRQ_B, 20 } };
+
+    Test_Run(trace, 2, Priority_1, Priority_5);
+    HOST_CHECK_EQ(Test_Stats[TEST_IRQ_A].Max_Latency_Cycles, NVIC_SIM_ENTRY_CYCLES);
+    HOST_CHECK_EQ(Test_Stats[TEST_IRQ_B].Max_Latency_Cycles,
+                  100 + NVIC_SIM_ENTRY_CYCLES + 50 + NVIC_SIM_TAIL_CHAIN_CYCLES - 130);
+    HOST_CHECK_EQ(Test_Stats[TEST_IRQ_B].Tail_Chains, 1);
+    HOST_CHECK_EQ(Test_Stats[TEST_IRQ_B].Preemptions, 0);
+}
+
+/* B lands at 105 during A's entry and takes it over at 112, then A tail-chains after B: 112 + 20 + 6 - 100 */
+static void Test_LateArrival(void)
+{
+    static const NVIC_SimEventType trace[] = { { 100, TEST_IRQ_A, 50 }, { 105, TEST_IRQ_B, 20 } };
+
+    Test_Run(trace, 2, Priority_5, Priority_1);
+    HOST_CHECK_EQ(Test_Stats[TEST_IRQ_B].Max_Latency_Cycles, 100 + NVIC_SIM_ENTRY_CYCLES - 105);
+    HOST_CHECK_EQ(Test_Stats[TEST_IRQ_B].Late_Arrivals, 1);
+    HOST_CHECK_EQ(Test_Stats[TEST_IRQ_A].Max_Latency_Cycles,
+                  NVIC_SIM_ENTRY_CYCLES + 20 + NVIC_SIM_TAIL_CHAIN_CYCLES);
+    HOST_CHECK_EQ(Test_Stats[TEST_IRQ_A].Tail_Chains, 1);
+}
+
+/* Levels 3 and 2 differ only in the sub-priority bit under PRIGROUP_5, so B no longer preempts A */
+static void Test_SubPriorityDoesNotPreempt(void)
+{
+    static const NVIC_SimEventType trace[] = { { 100, TEST_IRQ_A, 50 }, { 130, TEST_IRQ_B, 20 } };
+
+    Test_Run(trace, 2, Priority_3, Priority_2);
+    HOST_CHECK_EQ(Test_Stats[TEST_IRQ_B].Preemptions, 1);
+
+    NVIC_SetPriorityGrouping(PRIGROUP_5);
+    Test_Run(trace, 2, Priority_3, Priority_2);
+    HOST_CHECK_EQ(Test_Stats[TEST_IRQ_B].Preemptions, 0);
+    HOST_CHECK_EQ(Test_Stats[TEST_IRQ_B].Tail_Chains, 1);
+    HOST_CHECK_EQ(Test_Stats[TEST_IRQ_B].Max_Latency_Cycles,
+                  100 + NVIC_SIM_ENTRY_CYCLES + 50 + NVIC_SIM_TAIL_CHAIN_CYCLES - 130);
+}
+
+/* A second request while the first is still pending is merged into it */
+static void Test_LostRequest(void)
+{
+    static const NVIC_SimEventType trace[] = { { 100, TEST_IRQ_A, 50 }, { 120, TEST_IRQ_B, 20 }, { 125, TEST_IRQ_B, 20 } };
+
+    Test_Run(trace, 3, Priority_1, Priority_5);
+    HOST_CHECK_EQ(Test_Stats[TEST_IRQ_B].Count, 1);
+    HOST_CHECK_EQ(Test_Stats[TEST_IRQ_B].Lost, 1);
+}
+
+/* SysTick every 1000 cycles from 1000, nothing else: 9 ticks in 10000 cycles, each entered in 12 */
+static void Test_SysTickCountdown(void)
+{
+    static const NVIC_SimSysTickType systick = { 1000, 30 };
+    const NVIC_SimStatsType *stats = &Test_Stats[NVIC_SIM_SYSTICK_SOURCE];
+
+    NVIC_SetPriorityException(EXCEPTION_SYSTICK_TYPE, Priority_exception_7);
+    NVIC_SimRun(NULL_PTR, 0, &systick, TEST_DURATION, Test_Stats);
+    HOST_CHECK_EQ(stats->Count, 9);
+    HOST_CHECK_EQ(stats->Max_Latency_Cycles, NVIC_SIM_ENTRY_CYCLES);
+    HOST_CHECK_EQ(stats->Total_Latency_Cycles, 9 * NVIC_SIM_ENTRY_CYCLES);
+    HOST_CHECK_EQ(NVIC_SimPercentile(stats, 990), ((NVIC_SIM_ENTRY_CYCLES / NVIC_SIM_BUCKET_CYCLES) + 1) * NVIC_SIM_BUCKET_CYCLES);
+}
+
+int main(void)
+{
+    HOST_RUN(Test_Preemption);
+    HOST_RUN(Test_TailChain);
+    HOST_RUN(Test_LateArrival);
+    HOST_RUN(Test_SubPriorityDoesNotPreempt);
+    HOST_RUN(Test_LostRequest);
+    HOST_RUN(Test_SysTickCountdown);
+    return HOST_RESULT();
+}
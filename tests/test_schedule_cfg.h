@@ -0,0 +1,30 @@
+/******************************************************************************
+ *
+ * Module: Host
+ *
+ * File Name: test_schedule_cfg.h
+ *
+ * Description: Task table of test_systick_schedule.c. Force-included ahead of
+ *              systick_schedule.c so it replaces the empty table shipped in
+ *              systick_schedule_cfg.h.
+ *
+ * Author: Ahmed Osama
+ *
+ *******************************************************************************/
+
+#ifndef SYSTICK_SCHEDULE_CFG_H_
+#define SYSTICK_SCHEDULE_CFG_H_
+
+#include "std_types.h"
+
+/* Counts one run in the uint32 its context points at */
+void Test_TaskRun(void *Context);
+
+extern uint32 Test_FastRuns;
+extern uint32 Test_SlowRuns;
+
+#define SYSTICK_SCHEDULE_TABLE(ENTRY) \
+    ENTRY(FAST, Test_TaskRun, &Test_FastRuns,    4,  1, 100) \
+    ENTRY(SLOW, Test_TaskRun, &Test_SlowRuns, 1000, 10, 100) \
+
+#endif /* SYSTICK_SCHEDULE_CFG_H_ */
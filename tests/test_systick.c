@@ -0,0 +1,221 @@
+/******************************************************************************
+ *
+ * Module: Host
+ *
+ * File Name: test_systick.c
+ *
+ * Description: Register level tests of the SysTick driver on the host build.
+ *              The host counter moves Host_SysTick_Step cycles per access of
+ *              SYSTICK_CURRENT_REG while it is enabled.
+ *
+ * Author: Ahmed Osama
+ *
+ ******************************************************************************/
+#include "host_test.h"
+#include "nvic.h"
+#include "systick.h"
+#include "systick_timers.h"
+#include "nvic_coalesce.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* 1 ms tick at 16 MHz */
+#define TEST_RELOAD                          15999
+#define TEST_STEP                            100
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+static uint32 Test_Expiries[3];
+
+/* Cycles the counter ran during SysTick_TicklessIdle and how far each sleep overshoots its wrap */
+static uint64 Test_SleptCycles;
+static uint32 Test_PostWrapCycles;
+
+/* Time read by a reader preempting SysTick_Handler */
+static uint64 Test_PreemptCycles;
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+/* WFI: the counter runs through the loaded chunk and Test_PostWrapCycles more before the core wakes */
+static void Test_SleepPastWrap(void)
+{
+    uint32 cycles = Host_SysTick_Reload + 1 + Test_PostWrapCycles;
+
+    Host_SysTick_Step = cycles;
+    (void)Host_SysTickCurrent();
+    Host_SysTick_Step = 0;
+    Test_SleptCycles += cycles;
+}
+
+static void Test_CountExpiry(void *Context)
+{
+    (*(uint32 *)Context)++;
+}
+
+/* A delay on a stopped counter runs its own free-running counter and leaves CTRL and RELOAD as found */
+static void Test_DelayRestoresStoppedCounter(void)
+{
+    Host_SysTick_Ctrl = SYSTICK_CTRL_CLK_SRC_MASK | SYSTICK_CTRL_TICKINT_MASK;
+    Host_SysTick_Reload = TEST_RELOAD;
+    Host_SysTick_Step = TEST_STEP;
+
+    SysTick_DelayCycles(3 * SYSTICK_MAX_RELOAD);
+    HOST_CHECK_EQ(Host_SysTick_Ctrl, SYSTICK_CTRL_CLK_SRC_MASK | SYSTICK_CTRL_TICKINT_MASK);
+    HOST_CHECK_EQ(Host_SysTick_Reload, TEST_RELOAD);
+    HOST_CHECK_EQ(Host_SysTick_Current, 0);
+    HOST_CHECK_EQ(Host_Scb_Icsr & NVIC_ICSR_PENDSTSET_MASK, 0);
+}
+
+/* A delay on the running periodic tick does not touch its configuration */
+static void Test_DelayKeepsRunningCounter(void)
+{
+    uint32 ctrl = SYSTICK_CTRL_CLK_SRC_MASK | SYSTICK_CTRL_TICKINT_MASK | SYSTICK_CTRL_ENABLE_MASK;
+
+    Host_SysTick_Ctrl = ctrl;
+    Host_SysTick_Reload = TEST_RELOAD;
+    Host_SysTick_Current = 8000;
+    Host_SysTick_Step = TEST_STEP;
+
+    SysTick_DelayCycles(5 * (TEST_RELOAD + 1));
+    HOST_CHECK_EQ(Host_SysTick_Ctrl & ~SYSTICK_CTRL_COUNTFLAG_MASK, ctrl);
+    HOST_CHECK_EQ(Host_SysTick_Reload, TEST_RELOAD);
+}
+
+/* Every poll sees TEST_STEP cycles go by, the wait ends on the first poll that reaches the request */
+static void Test_DelayLength(void)
+{
+    Host_SysTick_Ctrl = SYSTICK_CTRL_CLK_SRC_MASK | SYSTICK_CTRL_ENABLE_MASK;
+    Host_SysTick_Reload = TEST_RELOAD;
+    Host_SysTick_Current = 8000;
+    Host_SysTick_Step = TEST_STEP;
+
+    Host_Register_Accesses = 0;
+    SysTick_DelayCycles(50 * TEST_STEP);
+    /* CTRL, RELOAD, the first CURRENT read and one read per step, SYSTICK_DELAY_OVERHEAD_CYCLES is 0 */
+    HOST_CHECK_EQ(Host_Register_Accesses, 3 + 50);
+}
+
+/* 1000 ticks slept through a low power mode: every expiry in the span fires, including one that
+ * had to be cascaded down from level 1, and the last tick is left to SysTick_Handler */
+static void Test_RestoreContextReplaysTimers(void)
+{
+    SysTick_TimerType timers[3];
+    SysTick_ContextType context;
+    uint32 i;
+
+    Host_SysTick_Ctrl = SYSTICK_CTRL_CLK_SRC_MASK | SYSTICK_CTRL_TICKINT_MASK | SYSTICK_CTRL_ENABLE_MASK;
+    Host_SysTick_Reload = TEST_RELOAD;
+    Host_SysTick_Current = 8000;
+    SysTick_TimerInit();
+    for (i = 0; i < 3; i++) {
+        Test_Expiries[i] = 0;
+        SysTick_TimerSetup(&timers[i], Test_CountExpiry, &Test_Expiries[i]);
+    }
+    SysTick_TimerStart(&timers[0], 3, 0);
+    SysTick_TimerStart(&timers[1], 200, 0);
+    SysTick_TimerStart(&timers[2], 10, 10);
+
+    SysTick_SaveContext(&context);
+    HOST_CHECK_EQ(SysTick_RestoreContext(&context, 8000 + (999 * (TEST_RELOAD + 1))), 1000);
+    HOST_CHECK_EQ(Test_Expiries[0], 1);
+    HOST_CHECK_EQ(Test_Expiries[1], 1);
+    HOST_CHECK_EQ(Test_Expiries[2], 99);
+    HOST_CHECK(Host_Scb_Icsr & NVIC_ICSR_PENDSTSET_MASK);
+
+    SysTick_Handler();
+    HOST_CHECK_EQ(Test_Expiries[2], 100);
+    HOST_CHECK_EQ(SysTick_TimerTicksToNext(), 10);
+}
+
+/* A timeout that falls inside skipped ticks is released by the next tick, and only once per batch */
+static void Test_CoalesceTimeoutAfterSkip(void)
+{
+    static NVIC_CoalesceType coalesce;
+    static NVIC_EventType buffer[16];
+    NVIC_CoalesceStatsType stats;
+
+    SysTick_TimerInit();
+    HOST_CHECK(NVIC_CoalesceCreate(&coalesce, UART2_RXTX, Priority_6, NULL_PTR, NULL_PTR, buffer, 16));
+    NVIC_CoalesceSetThresholds(&coalesce, 8, 5);
+    HOST_CHECK_EQ(NVIC_CoalesceTicksToNext(), 0xFFFFFFFF);
+
+    HOST_CHECK(NVIC_CoalescePost(&coalesce, 1));
+    NVIC_CoalesceTick();
+    HOST_CHECK_EQ(NVIC_CoalesceTicksToNext(), 4);
+    HOST_CHECK_EQ(SysTick_IdleTicks(), 4);
+
+    NVIC_CoalesceSkip(10);
+    HOST_CHECK_EQ(NVIC_CoalesceTicksToNext(), 1);
+    NVIC_CoalesceTick();
+    NVIC_CoalesceTick();
+    NVIC_CoalesceGetStats(&coalesce, &stats);
+    HOST_CHECK_EQ(stats.Timeout_Flushes, 1);
+    HOST_CHECK_EQ(Host_Nvic_Stir, UART2_RXTX);
+    HOST_CHECK_EQ(NVIC_CoalesceTicksToNext(), 0xFFFFFFFF);
+}
+
+/* Three chained sleeps that each wake 10000 cycles after their wrap: the ticks accounted must be
+ * the ticks that really went by, the cycles past each wrap are not dropped */
+static void Test_TicklessCountsPastWrap(void)
+{
+    uint32 elapsed_ticks;
+
+    Host_SysTick_Ctrl = SYSTICK_CTRL_CLK_SRC_MASK | SYSTICK_CTRL_TICKINT_MASK | SYSTICK_CTRL_ENABLE_MASK;
+    Host_SysTick_Reload = TEST_RELOAD;
+    Host_SysTick_Current = 8000;
+    SysTick_TimerInit();
+    Test_SleptCycles = 0;
+    Test_PostWrapCycles = 10000;
+    Host_Wfi_Hook = Test_SleepPastWrap;
+
+    elapsed_ticks = SysTick_TicklessIdle(3000);
+    HOST_CHECK_EQ(Test_SleptCycles, 8000 + (2999 * (TEST_RELOAD + 1)) + Test_PostWrapCycles);
+    HOST_CHECK_EQ(elapsed_ticks, 1 + ((Test_SleptCycles - 8000) / (TEST_RELOAD + 1)));
+    HOST_CHECK_EQ(Host_SysTick_Reload, TEST_RELOAD);
+    HOST_CHECK(Host_Scb_Icsr & NVIC_ICSR_PENDSTSET_MASK);
+}
+
+/* Higher priority reader preempting SysTick_Handler at its first SysTick register access */
+static void Test_PreemptingReader(void)
+{
+    Host_SysTick_Hook = NULL_PTR;
+    Test_PreemptCycles = SysTick_GetCycles();
+}
+
+/* The handler is active, so PENDSTSET is clear, but the wrap is not published yet: a reader in that
+ * window must still count the period that just ended */
+static void Test_TimeReadInsideHandler(void)
+{
+    uint64 before;
+
+    Host_SysTick_Ctrl = SYSTICK_CTRL_CLK_SRC_MASK | SYSTICK_CTRL_TICKINT_MASK | SYSTICK_CTRL_ENABLE_MASK;
+    Host_SysTick_Reload = TEST_RELOAD;
+    Host_SysTick_Current = 5;
+    before = SysTick_GetCycles();
+
+    /* 15 cycles later the counter has wrapped and the exception is entered */
+    Host_SysTick_Current = TEST_RELOAD - 9;
+    Host_SysTick_Hook = Test_PreemptingReader;
+    SysTick_Handler();
+    HOST_CHECK_EQ(Host_SysTick_Hook, NULL_PTR);
+    HOST_CHECK_EQ(Test_PreemptCycles, before + 15);
+    HOST_CHECK_EQ(SysTick_GetCycles(), before + 15);
+}
+
+int main(void)
+{
+    HOST_RUN(Test_DelayRestoresStoppedCounter);
+    HOST_RUN(Test_DelayKeepsRunningCounter);
+    HOST_RUN(Test_DelayLength);
+    HOST_RUN(Test_RestoreContextReplaysTimers);
+    HOST_RUN(Test_CoalesceTimeoutAfterSkip);
+    HOST_RUN(Test_TicklessCountsPastWrap);
+    HOST_RUN(Test_TimeReadInsideHandler);
+    return HOST_RESULT();
+}
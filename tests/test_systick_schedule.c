@@ -0,0 +1,70 @@
+/******************************************************************************
+ *
+ * Module: Host
+ *
+ * File Name: test_systick_schedule.c
+ *
+ * Description: Host tests of the multi-rate schedule, built with its own copy
+ *              of systick_schedule.c running the table of test_schedule_cfg.h.
+ *
+ * Author: Ahmed Osama
+ *
+ ******************************************************************************/
+#include "host_test.h"
+#include "systick_schedule.h"
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+
+uint32 Test_FastRuns;
+uint32 Test_SlowRuns;
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+void Test_TaskRun(void *Context)
+{
+    (*(uint32 *)Context)++;
+}
+
+static void Test_Init(void)
+{
+    Test_FastRuns = 0;
+    Test_SlowRuns = 0;
+    SysTick_ScheduleInit();
+}
+
+/* FAST runs on ticks 1, 5, 9, ... and SLOW on tick 10 of every 1000 */
+static void Test_RatesAndPhases(void)
+{
+    uint32 tick;
+
+    Test_Init();
+    for (tick = 0; tick < 2000; tick++) {
+        SysTick_ScheduleTick();
+    }
+    HOST_CHECK_EQ(Test_FastRuns, 500);
+    HOST_CHECK_EQ(Test_SlowRuns, 2);
+    HOST_CHECK_EQ(SysTick_ScheduleTicksToNext(), 2);
+}
+
+/* A skip past a due run leaves the task due, it must not wrap into a countdown of ~65536 ticks */
+static void Test_SkipPastDueRunsNextTick(void)
+{
+    Test_Init();
+    SysTick_ScheduleSkip(0x10000 + 2);
+    HOST_CHECK_EQ(SysTick_ScheduleTicksToNext(), 1);
+    SysTick_ScheduleTick();
+    HOST_CHECK_EQ(Test_FastRuns, 1);
+    HOST_CHECK_EQ(Test_SlowRuns, 1);
+    HOST_CHECK_EQ(SysTick_ScheduleTicksToNext(), 4);
+}
+
+int main(void)
+{
+    HOST_RUN(Test_RatesAndPhases);
+    HOST_RUN(Test_SkipPastDueRunsNextTick);
+    return HOST_RESULT();
+}